@@ -0,0 +1,327 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "AdaptorOCL/OCL/KernelCache.h"
+
+#include "common/LLVMWarningsPush.hpp"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+#include "common/LLVMWarningsPop.hpp"
+
+#include "Compiler/CISACodeGen/Platform.hpp"
+#include "common/igc_regkeys.hpp"
+#include "common/Stats.hpp"
+#include "common/secure_mem.h"
+#include "version.h"
+
+#include <cstring>
+#include <type_traits>
+
+using namespace llvm;
+
+namespace TC
+{
+namespace KernelCache
+{
+    // Entries are named with the prefix llvm::pruneCache looks for
+    static const char* const s_entryPrefix = "llvmcache-";
+
+    static const char s_entryMagic[8] = { 'I', 'G', 'C', 'K', 'C', 'v', '1', '\0' };
+
+    struct EntryHeader
+    {
+        char     Magic[8];
+        uint32_t OutputSize;
+        uint32_t DebugDataSize;
+        uint32_t MessageSize;
+    };
+
+    static bool GetCacheDirectory(SmallVectorImpl<char>& dir)
+    {
+        const char* regkeyDir = IGC_GET_REGKEYSTRING(KernelCacheDir);
+        if (regkeyDir && regkeyDir[0] != '\0')
+        {
+            dir.assign(regkeyDir, regkeyDir + strlen(regkeyDir));
+            return true;
+        }
+        if (!sys::path::cache_directory(dir))
+        {
+            return false;
+        }
+        sys::path::append(dir, "igc");
+        return true;
+    }
+
+    static void GetEntryPath(const std::string& key, SmallVectorImpl<char>& path)
+    {
+        path.clear();
+        if (GetCacheDirectory(path))
+        {
+            sys::path::append(path, s_entryPrefix + key);
+        }
+    }
+
+    static void HashBytes(MD5& hash, const void* pData, size_t size)
+    {
+        uint64_t size64 = size;
+        hash.update(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(&size64), sizeof(size64)));
+        if (size)
+        {
+            hash.update(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(pData), size));
+        }
+    }
+
+    static void HashString(MD5& hash, const char* pStr)
+    {
+        HashBytes(hash, pStr, pStr ? strlen(pStr) : 0);
+    }
+
+    template <typename T>
+    static void HashValue(MD5& hash, T value)
+    {
+        static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+            "only scalar values have a padding-free representation");
+        hash.update(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(&value), sizeof(value)));
+    }
+
+    // The platform structs are hashed field by field: the driver hands them
+    // over by value, so their padding and reserved members are not reliable.
+    static void HashPlatform(MD5& hash, const IGC::CPlatform& platform)
+    {
+        const PLATFORM& info = platform.getPlatformInfo();
+        HashValue(hash, info.eProductFamily);
+        HashValue(hash, info.ePCHProductFamily);
+        HashValue(hash, info.eDisplayCoreFamily);
+        HashValue(hash, info.eRenderCoreFamily);
+        HashValue(hash, info.ePlatformType);
+        HashValue(hash, info.usDeviceID);
+        HashValue(hash, info.usRevId);
+        HashValue(hash, info.usDeviceID_PCH);
+        HashValue(hash, info.usRevId_PCH);
+        HashValue(hash, info.eGTType);
+        HashValue(hash, info.sDisplayBlockID.Value);
+        HashValue(hash, info.sDisplayPicaBlockID.Value);
+        HashValue(hash, info.sRenderBlockID.Value);
+        HashValue(hash, info.sMediaBlockID.Value);
+        HashValue(hash, info.usOriginalRevIdFromPciConfig);
+
+        // Only the members IGC::SetGTSystemInfo fills in from the driver
+        const GT_SYSTEM_INFO sysInfo = platform.GetGTSystemInfo();
+        HashValue(hash, sysInfo.EUCount);
+        HashValue(hash, sysInfo.ThreadCount);
+        HashValue(hash, sysInfo.SliceCount);
+        HashValue(hash, sysInfo.SubSliceCount);
+        HashValue(hash, sysInfo.SLMSizeInKb);
+        HashValue(hash, sysInfo.TotalPsThreadsWindowerRange);
+        HashValue(hash, sysInfo.TotalVsThreads);
+        HashValue(hash, sysInfo.TotalVsThreads_Pocs);
+        HashValue(hash, sysInfo.TotalDsThreads);
+        HashValue(hash, sysInfo.TotalGsThreads);
+        HashValue(hash, sysInfo.TotalHsThreads);
+        HashValue(hash, sysInfo.MaxEuPerSubSlice);
+        HashValue(hash, sysInfo.EuCountPerPoolMax);
+        HashValue(hash, sysInfo.EuCountPerPoolMin);
+        HashValue(hash, sysInfo.MaxSlicesSupported);
+        HashValue(hash, sysInfo.MaxSubSlicesSupported);
+        HashValue(hash, sysInfo.IsDynamicallyPopulated);
+        HashValue(hash, sysInfo.CsrSizeInMb);
+
+        const WA_TABLE& waTable = platform.getWATable();
+#define WA_DECLARE(wa, wa_comment, wa_bugType, wa_impact, wa_component) \
+        HashValue(hash, static_cast<unsigned int>(waTable.wa));
+#include "inc/common/sku_wa_defs.h"
+#undef WA_DECLARE
+
+        // The SKU table is a bitfield struct with unnamed bits; it is
+        // memset to zero by IGC::ConvertSkuTable before it is filled in.
+        const SKU_FEATURE_TABLE& skuTable = platform.getSkuTable();
+        HashBytes(hash, &skuTable, sizeof(skuTable));
+    }
+
+    std::string GetKey(
+        const STB_TranslateInputArgs* pInputArgs,
+        TB_DATA_FORMAT inputDataFormat,
+        const IGC::CPlatform& platform,
+        float profilingTimerResolution)
+    {
+#ifdef IGC_REVISION
+        const char* revision = IGC_REVISION;
+#else
+        // Without a revision binaries of different IGC builds can't be told apart
+        const char* revision = nullptr;
+#endif
+        if (IGC_IS_FLAG_DISABLED(EnableKernelCache) || !revision)
+        {
+            return "";
+        }
+
+        // Builds that are expected to have side effects or that take input
+        // the key can't capture always go through the compiler.
+        if (IGC_IS_FLAG_ENABLED(ShaderDumpEnable) ||
+            IGC_IS_FLAG_ENABLED(ShaderOverride) ||
+            pInputArgs->GTPinInput ||
+            pInputArgs->pTracingOptions ||
+            pInputArgs->CompileTimeStatisticsEnable ||
+            IGC::TraceEventsEnabled())
+        {
+            return "";
+        }
+
+        MD5 hash;
+        HashString(hash, revision);
+        HashBytes(hash, &inputDataFormat, sizeof(inputDataFormat));
+        HashBytes(hash, pInputArgs->pInput, pInputArgs->InputSize);
+        HashBytes(hash, pInputArgs->pOptions, pInputArgs->OptionsSize);
+        HashBytes(hash, pInputArgs->pInternalOptions, pInputArgs->InternalOptionsSize);
+        HashBytes(hash, pInputArgs->pSpecConstantsIds,
+            pInputArgs->SpecConstantsSize * sizeof(*pInputArgs->pSpecConstantsIds));
+        HashBytes(hash, pInputArgs->pSpecConstantsValues,
+            pInputArgs->SpecConstantsSize * sizeof(*pInputArgs->pSpecConstantsValues));
+        for (uint32_t i = 0; i < pInputArgs->NumVISAAsmsToLink; ++i)
+        {
+            HashString(hash, pInputArgs->pVISAAsmToLinkArray[i]);
+        }
+        for (uint32_t i = 0; i < pInputArgs->NumDirectCallFunctions; ++i)
+        {
+            HashString(hash, pInputArgs->pDirectCallFunctions[i]);
+        }
+
+        HashPlatform(hash, platform);
+        HashBytes(hash, &profilingTimerResolution, sizeof(profilingTimerResolution));
+
+        std::string keyValues, optionKeys;
+        GetKeysSetExplicitly(&keyValues, &optionKeys);
+        HashBytes(hash, keyValues.data(), keyValues.size());
+
+        MD5::MD5Result result;
+        hash.final(result);
+        return result.digest().str().str();
+    }
+
+    bool Load(const std::string& key, STB_TranslateOutputArgs& outputArgs)
+    {
+        SmallString<256> path;
+        GetEntryPath(key, path);
+        if (path.empty())
+        {
+            return false;
+        }
+
+        ErrorOr<std::unique_ptr<MemoryBuffer>> bufferOrErr = MemoryBuffer::getFile(path);
+        if (!bufferOrErr)
+        {
+            return false;
+        }
+        const MemoryBuffer& buffer = **bufferOrErr;
+
+        EntryHeader header;
+        if (buffer.getBufferSize() < sizeof(header))
+        {
+            return false;
+        }
+        memcpy_s(&header, sizeof(header), buffer.getBufferStart(), sizeof(header));
+        uint64_t payloadSize = (uint64_t)header.OutputSize + header.DebugDataSize + header.MessageSize;
+        if (memcmp(header.Magic, s_entryMagic, sizeof(s_entryMagic)) != 0 ||
+            header.OutputSize == 0 ||
+            buffer.getBufferSize() != sizeof(header) + payloadSize)
+        {
+            return false;
+        }
+
+        auto copyBlob = [](const char*& pSrc, uint32_t size, char*& pDst, uint32_t& dstSize) {
+            if (size == 0)
+            {
+                return;
+            }
+            pDst = new char[size];
+            dstSize = size;
+            memcpy_s(pDst, size, pSrc, size);
+            pSrc += size;
+        };
+        const char* pSrc = buffer.getBufferStart() + sizeof(header);
+        copyBlob(pSrc, header.OutputSize, outputArgs.pOutput, outputArgs.OutputSize);
+        copyBlob(pSrc, header.DebugDataSize, outputArgs.pDebugData, outputArgs.DebugDataSize);
+        copyBlob(pSrc, header.MessageSize, outputArgs.pErrorString, outputArgs.ErrorStringSize);
+
+        // Refresh the access time the pruning uses to pick the least recently
+        // used entries
+        int FD = -1;
+        if (!sys::fs::openFileForRead(path, FD))
+        {
+            sys::fs::setLastAccessAndModificationTime(FD, std::chrono::system_clock::now());
+            sys::Process::SafelyCloseFileDescriptor(FD);
+        }
+        return true;
+    }
+
+    void Store(const std::string& key, const STB_TranslateOutputArgs& outputArgs)
+    {
+        if (outputArgs.pOutput == nullptr || outputArgs.OutputSize == 0)
+        {
+            return;
+        }
+
+        SmallString<256> dir;
+        if (!GetCacheDirectory(dir) || sys::fs::create_directories(dir))
+        {
+            return;
+        }
+
+        SmallString<256> tempModel(dir);
+        sys::path::append(tempModel, "igc-tmp-%%%%%%%%%%%%");
+        Expected<sys::fs::TempFile> tempOrErr = sys::fs::TempFile::create(tempModel);
+        if (!tempOrErr)
+        {
+            consumeError(tempOrErr.takeError());
+            return;
+        }
+        sys::fs::TempFile& temp = *tempOrErr;
+
+        EntryHeader header;
+        memcpy_s(header.Magic, sizeof(header.Magic), s_entryMagic, sizeof(s_entryMagic));
+        header.OutputSize = outputArgs.OutputSize;
+        header.DebugDataSize = outputArgs.pDebugData ? outputArgs.DebugDataSize : 0;
+        header.MessageSize = outputArgs.pErrorString ? outputArgs.ErrorStringSize : 0;
+
+        bool writeFailed = false;
+        {
+            raw_fd_ostream OS(temp.FD, /* shouldClose */ false);
+            OS.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            OS.write(outputArgs.pOutput, header.OutputSize);
+            if (header.DebugDataSize)
+                OS.write(outputArgs.pDebugData, header.DebugDataSize);
+            if (header.MessageSize)
+                OS.write(outputArgs.pErrorString, header.MessageSize);
+            OS.flush();
+            writeFailed = OS.has_error();
+            OS.clear_error();
+        }
+
+        // The rename done by keep() is atomic, so concurrent builds either see
+        // the complete entry or none.
+        SmallString<256> path(dir);
+        sys::path::append(path, s_entryPrefix + key);
+        Error E = writeFailed ? temp.discard() : temp.keep(path);
+        consumeError(std::move(E));
+
+        CachePruningPolicy policy;
+        policy.MaxSizeBytes = (uint64_t)IGC_GET_FLAG_VALUE(KernelCacheMaxSizeMB) * 1024 * 1024;
+        pruneCache(dir, policy);
+    }
+
+} // namespace KernelCache
+} // namespace TC
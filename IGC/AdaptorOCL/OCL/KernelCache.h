@@ -0,0 +1,45 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "AdaptorOCL/TranslationBlock.h"
+
+#include <string>
+
+namespace IGC
+{
+    class CPlatform;
+}
+
+namespace TC
+{
+namespace KernelCache
+{
+    /// GetKey - Returns the key of the on-disk cache entry for a build, computed
+    /// from everything that affects its output: the input, the options, the
+    /// platform description, explicitly set regkeys and the IGC revision.
+    /// Returns an empty string if the cache is disabled or the build must
+    /// not be cached.
+    std::string GetKey(
+        const STB_TranslateInputArgs* pInputArgs,
+        TB_DATA_FORMAT inputDataFormat,
+        const IGC::CPlatform& platform,
+        float profilingTimerResolution);
+
+    /// Load - Fills outputArgs from the cache entry with the given key.
+    /// Returns false on a cache miss.
+    bool Load(const std::string& key, STB_TranslateOutputArgs& outputArgs);
+
+    /// Store - Writes the output of a successful build to the cache entry with
+    /// the given key and evicts the least recently used entries if the cache
+    /// grew over its size limit.
+    void Store(const std::string& key, const STB_TranslateOutputArgs& outputArgs);
+
+} // namespace KernelCache
+} // namespace TC
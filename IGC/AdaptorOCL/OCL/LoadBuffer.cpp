@@ -48,8 +48,10 @@ MemoryBuffer *llvm::LoadBufferFromResource(const char *pResName,
         return NULL;
     }
 
-    // Create a copy of the buffer for the caller. This copy is managed
-    return MemoryBuffer::getMemBufferCopy(StringRef((char *)symbol, size)).release();
+    // The data is part of the loaded library image, so like on Windows it is
+    // referenced rather than copied and shared by all translations in the
+    // process.
+    return MemoryBuffer::getMemBuffer(StringRef((char *)symbol, size), "", false).release();
 }
 
 #endif
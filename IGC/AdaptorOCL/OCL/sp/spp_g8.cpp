@@ -453,7 +453,8 @@ bool CGen8OpenCLProgramBase::dumpElfKernelMapFile(IGC::CodeGenContext* Ctx)
 }
 
 bool CGen8OpenCLProgram::GetZEBinary(
-    llvm::raw_pwrite_stream& programBinary,
+    std::unique_ptr<char[]>& programBinary,
+    size_t& programBinarySize,
     unsigned pointerSizeInBytes,
     const char* spv, uint32_t spvSize,
     const char* metrics, uint32_t metricsSize,
@@ -788,7 +789,7 @@ bool CGen8OpenCLProgram::GetZEBinary(
         }
     }
 
-    zebuilder.getBinaryObject(programBinary);
+    programBinary = zebuilder.getBinaryObject(programBinarySize);
 
     // dump .ze_info to a file
     if (IGC_IS_FLAG_ENABLED(ShaderDumpEnable))
@@ -106,10 +106,12 @@ public:
     /// m_ProgramScopePatchStream and m_KernelBinaries
     void CreateKernelBinaries();
 
-    /// getZEBinary - create and get ZE Binary
+    /// getZEBinary - create and get ZE Binary, written into a buffer of its
+    /// exact size that is returned in programBinary and programBinarySize
     /// if spv and spvSize are given, a .spv section will be created in the output ZEBinary
     bool GetZEBinary(
-        llvm::raw_pwrite_stream& programBinary,
+        std::unique_ptr<char[]>& programBinary,
+        size_t& programBinarySize,
         unsigned pointerSizeInBytes,
         const char* spv,          uint32_t spvSize,
         const char* metrics,      uint32_t metricsSize,
@@ -895,6 +895,16 @@ void ZEBinaryBuilder::getBinaryObject(llvm::raw_pwrite_stream& os)
     mBuilder.finalize(os);
 }
 
+std::unique_ptr<char[]> ZEBinaryBuilder::getBinaryObject(size_t& size)
+{
+    if (!mZEInfoBuilder.empty())
+        mBuilder.addSectionZEInfo(mZEInfoBuilder.getZEInfoContainer());
+    size = mBuilder.getBinarySize();
+    std::unique_ptr<char[]> buffer(new char[size]);
+    mBuilder.finalize((uint8_t*)buffer.get(), size);
+    return buffer;
+}
+
 void ZEBinaryBuilder::getBinaryObject(Util::BinaryStream& outputStream)
 {
     llvm::SmallVector<char, 64> buf;
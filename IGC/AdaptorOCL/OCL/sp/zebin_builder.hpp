@@ -83,6 +83,10 @@ public:
     /// getBinaryObject - get the final ze object
     void getBinaryObject(llvm::raw_pwrite_stream& os);
 
+    /// getBinaryObject - write the final ze object into a buffer allocated
+    /// with its exact size, so that no intermediate copy is made
+    std::unique_ptr<char[]> getBinaryObject(size_t& size);
+
     // getBinaryObject - write the final object into given Util::BinaryStream
     // Avoid using this function, which has extra buffer copy
     void getBinaryObject(Util::BinaryStream& outputStream);
@@ -75,6 +75,7 @@ THE SOFTWARE.
 
 #include <iostream>
 #include <fstream>
+#include <unordered_set>
 
 #include "Probe/Assertion.h"
 
@@ -1490,8 +1491,10 @@ private:
 
 class SPIRVToLLVM {
 public:
-  SPIRVToLLVM(Module *LLVMModule, SPIRVModule *TheSPIRVModule)
-    :M((IGCLLVM::Module*)LLVMModule), BM(TheSPIRVModule), DbgTran(BM, M, this){
+  SPIRVToLLVM(Module *LLVMModule, SPIRVModule *TheSPIRVModule,
+      const std::vector<std::string> *TheEntryPoints = nullptr)
+    :M((IGCLLVM::Module*)LLVMModule), BM(TheSPIRVModule), DbgTran(BM, M, this),
+     EntryPoints(TheEntryPoints){
       if (M)
           Context = &M->getContext();
       else
@@ -1524,6 +1527,8 @@ public:
   std::vector<Value *> transValue(const std::vector<SPIRVValue *>&, Function *F,
       BasicBlock *, BoolAction Action = BoolAction::Promote);
   Function *transFunction(SPIRVFunction *F);
+  bool isTranslationRoot(SPIRVFunction *F) const;
+  bool checkEntryPoints();
   bool transFPContractMetadata();
   bool transKernelMetadata();
   bool transNonTemporalMetadata(Instruction* I);
@@ -1589,6 +1594,8 @@ private:
   SPIRVToLLVMFunctionMap FuncMap;
   SPIRVToLLVMPlaceholderMap PlaceholderMap;
   SPIRVToLLVMDbgTran DbgTran;
+  // When set, only these kernels and the functions they reach are translated.
+  const std::vector<std::string> *EntryPoints;
   GlobalVariable *m_NamedBarrierVar;
   GlobalVariable *m_named_barrier_id;
   DICompileUnit* compileUnit = nullptr;
@@ -4528,6 +4535,8 @@ bool
 SPIRVToLLVM::translate() {
   if (!transAddressingModel())
     return false;
+  if (!checkEntryPoints())
+    return false;
 
   compileUnit = DbgTran.createCompileUnit();
 
@@ -4537,8 +4546,12 @@ SPIRVToLLVM::translate() {
       transValue(BV, nullptr, nullptr, true, BoolAction::Noop);
   }
 
+  // Callees are translated on demand from their calls, as are the debug info
+  // subprograms and types of everything translated.
   for (unsigned I = 0, E = BM->getNumFunctions(); I != E; ++I) {
-    transFunction(BM->getFunction(I));
+    SPIRVFunction *BF = BM->getFunction(I);
+    if (isTranslationRoot(BF))
+      transFunction(BF);
   }
   for(auto& funcs : FuncMap)
   {
@@ -4566,6 +4579,38 @@ SPIRVToLLVM::translate() {
   return true;
 }
 
+// Whether F must be translated regardless of whether anything calls it.
+bool
+SPIRVToLLVM::isTranslationRoot(SPIRVFunction *F) const {
+  if (!EntryPoints)
+    return true;
+  if (BM->isEntryPoint(ExecutionModelKernel, F->getId()))
+    return std::find(EntryPoints->begin(), EntryPoints->end(),
+                     F->getName()) != EntryPoints->end();
+  // Functions may also be reached through function pointers or from other
+  // modules linked in later, keep those.
+  return F->hasDecorate(DecorationReferencedIndirectlyINTEL) ||
+         F->getLinkageType() == LinkageTypeExport;
+}
+
+// Every requested entry point must name a kernel in the module, otherwise a
+// misspelled name silently yields a program without it.
+bool
+SPIRVToLLVM::checkEntryPoints() {
+  if (!EntryPoints)
+    return true;
+  std::unordered_set<std::string> Kernels;
+  for (unsigned I = 0, E = BM->getNumFunctions(); I != E; ++I) {
+    SPIRVFunction *BF = BM->getFunction(I);
+    if (BM->isEntryPoint(ExecutionModelKernel, BF->getId()))
+      Kernels.insert(BF->getName());
+  }
+  for (const std::string &Name : *EntryPoints)
+    SPIRVCKRT(Kernels.count(Name), InvalidEntryPoint,
+              "No kernel named " + Name + ".");
+  return true;
+}
+
 bool
 SPIRVToLLVM::transAddressingModel() {
   switch (BM->getAddressingModel()) {
@@ -4655,7 +4700,7 @@ SPIRVToLLVM::transFPContractMetadata() {
   bool ContractOff = false;
   for (unsigned I = 0, E = BM->getNumFunctions(); I != E; ++I) {
     SPIRVFunction *BF = BM->getFunction(I);
-    if (!isOpenCLKernel(BF))
+    if (!isOpenCLKernel(BF) || !getTranslatedValue(BF))
       continue;
     if (BF->getExecutionMode(ExecutionModeContractionOff)) {
       ContractOff = true;
@@ -4822,6 +4867,8 @@ SPIRVToLLVM::transKernelMetadata()
     {
         SPIRVFunction *BF = BM->getFunction(I);
         Function *F = static_cast<Function *>(getTranslatedValue(BF));
+        if (!F && EntryPoints)
+            continue;
         IGC_ASSERT_MESSAGE(F, "Invalid translated function");
 
         transFunctionDecorationsToMetadata(BF, F);
@@ -5238,7 +5285,8 @@ __attr_unused static void dumpSPIRVBC(const char* fname, const char* data, unsig
 
 bool ReadSPIRV(LLVMContext &C, std::istream &IS, Module *&M,
     std::string &ErrMsg,
-    std::unordered_map<uint32_t, uint64_t> *specConstants) {
+    std::unordered_map<uint32_t, uint64_t> *specConstants,
+    const std::vector<std::string> *entryPoints) {
   std::unique_ptr<SPIRVModule> BM( SPIRVModule::createSPIRVModule() );
   BM->setSpecConstantMap(specConstants);
   IS >> *BM;
@@ -5246,7 +5294,7 @@ bool ReadSPIRV(LLVMContext &C, std::istream &IS, Module *&M,
   if (Succeed) {
     BM->resolveUnknownStructFields();
     M = new Module("", C);
-    SPIRVToLLVM BTL(M, BM.get());
+    SPIRVToLLVM BTL(M, BM.get(), entryPoints);
 
     if (!BTL.translate()) {
       BM->getError(ErrMsg);
@@ -20,14 +20,19 @@ See LICENSE.TXT for details.
 
 #include "llvm/IR/Module.h"
 
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace igc_spv{
 // Loads SPIRV from istream and translate to LLVM module.
+// If entryPoints is given, only those kernels and the functions reachable
+// from them are translated.
 // Returns true if succeeds.
 bool ReadSPIRV(llvm::LLVMContext &C, std::istream &IS, llvm::Module *&M,
     std::string &ErrMsg,
-    std::unordered_map<uint32_t, uint64_t> *specConstants);
+    std::unordered_map<uint32_t, uint64_t> *specConstants,
+    const std::vector<std::string> *entryPoints = nullptr);
 
 }
 #endif
@@ -14,3 +14,4 @@ _SPIRV_OP(InvalidMemoryModel, "Expects 0-3.")
 _SPIRV_OP(InvalidFunctionControlMask,"")
 _SPIRV_OP(InvalidBuiltinSetName, "Expects OpenCL12, OpenCL20.")
 _SPIRV_OP(UnsupportedSPIRVOpcode, "")
+_SPIRV_OP(InvalidEntryPoint, "Expects the name of a kernel in the module.")
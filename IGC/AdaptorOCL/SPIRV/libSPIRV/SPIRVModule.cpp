@@ -205,36 +205,36 @@ public:
 
   virtual SPIRVExtInst* getCompilationUnit() const override
   {
-      for (auto& item : IdEntryMap)
+      SPIRVExtInst* compileUnit = nullptr;
+      forEachIdEntry([&](SPIRVEntry* entry)
       {
-          if (item.second->getOpCode() == igc_spv::Op::OpExtInst)
-          {
-              auto extInst = static_cast<SPIRVExtInst*>(item.second);
-              if ((extInst->getExtSetKind() == SPIRVExtInstSetKind::SPIRVEIS_DebugInfo ||
-                  extInst->getExtSetKind() == SPIRVExtInstSetKind::SPIRVEIS_OpenCL_DebugInfo_100) &&
-                  extInst->getExtOp() == OCLExtOpDbgKind::CompileUnit)
-                  return extInst;
-          }
-      }
-
-      return nullptr;
+          if (compileUnit || entry->getOpCode() != igc_spv::Op::OpExtInst)
+              return;
+          auto extInst = static_cast<SPIRVExtInst*>(entry);
+          if ((extInst->getExtSetKind() == SPIRVExtInstSetKind::SPIRVEIS_DebugInfo ||
+              extInst->getExtSetKind() == SPIRVExtInstSetKind::SPIRVEIS_OpenCL_DebugInfo_100) &&
+              extInst->getExtOp() == OCLExtOpDbgKind::CompileUnit)
+              compileUnit = extInst;
+      });
+
+      return compileUnit;
   }
 
   virtual std::vector<SPIRVExtInst*> getGlobalVars() override
   {
       std::vector<SPIRVExtInst*> globalVars;
 
-      for (auto& item : IdEntryMap)
+      forEachIdEntry([&](SPIRVEntry* entry)
       {
-          if (item.second->getOpCode() == igc_spv::Op::OpExtInst)
+          if (entry->getOpCode() == igc_spv::Op::OpExtInst)
           {
-              auto extInst = static_cast<SPIRVExtInst*>(item.second);
+              auto extInst = static_cast<SPIRVExtInst*>(entry);
               if ((extInst->getExtSetKind() == SPIRVExtInstSetKind::SPIRVEIS_DebugInfo ||
                   extInst->getExtSetKind() == SPIRVExtInstSetKind::SPIRVEIS_OpenCL_DebugInfo_100) &&
                   extInst->getExtOp() == OCLExtOpDbgKind::GlobalVariable)
                   globalVars.push_back(extInst);
           }
-      }
+      });
 
       return globalVars;
   }
@@ -243,11 +243,11 @@ public:
   {
       std::vector<SPIRVExtInst*> importedEntities;
 
-      for (auto& item : IdEntryMap)
+      forEachIdEntry([&](SPIRVEntry* entry)
       {
-          if (item.second->getOpCode() == igc_spv::Op::OpExtInst)
+          if (entry->getOpCode() == igc_spv::Op::OpExtInst)
           {
-              auto extInst = static_cast<SPIRVExtInst*>(item.second);
+              auto extInst = static_cast<SPIRVExtInst*>(entry);
               if ((extInst->getExtSetKind() == SPIRVExtInstSetKind::SPIRVEIS_DebugInfo ||
                   extInst->getExtSetKind() == SPIRVExtInstSetKind::SPIRVEIS_OpenCL_DebugInfo_100) &&
                   extInst->getExtOp() == OCLExtOpDbgKind::ImportedEntity)
@@ -255,7 +255,7 @@ public:
                   importedEntities.push_back(extInst);
               }
           }
-      }
+      });
 
       return importedEntities;
   }
@@ -264,17 +264,17 @@ public:
   {
       std::vector<SPIRVValue*> specConstants;
 
-      for (auto& item : IdEntryMap)
+      forEachIdEntry([&](SPIRVEntry* entry)
       {
-          Op opcode = item.second->getOpCode();
+          Op opcode = entry->getOpCode();
           if (opcode == igc_spv::Op::OpSpecConstant ||
               opcode == igc_spv::Op::OpSpecConstantTrue ||
               opcode == igc_spv::Op::OpSpecConstantFalse)
           {
-              auto specConstant = static_cast<SPIRVValue*>(item.second);
+              auto specConstant = static_cast<SPIRVValue*>(entry);
               specConstants.push_back(specConstant);
           }
-      }
+      });
 
       return specConstants;
   }
@@ -296,7 +296,9 @@ private:
   SPIRVMemoryModelKind MemoryModel;
   std::string ModuleProcessed;
 
-  typedef std::map<SPIRVId, SPIRVEntry *> SPIRVIdToEntryMap;
+  // SPIR-V ids are dense and bounded by the header, so entries are indexed
+  // by id. Unused ids map to null.
+  typedef std::vector<SPIRVEntry *> SPIRVIdToEntryVec;
   typedef std::map<SPIRVTypeStruct*,
       std::vector<std::pair<unsigned, SPIRVId> > > SPIRVUnknownStructFieldMap;
   typedef std::vector<SPIRVEntry*> SPIRVAliasInstMDVec;
@@ -318,7 +320,12 @@ private:
   typedef std::vector<SPIRVEntryPoint*> SPIRVEntryPointVec;
 
   SPIRVAsmVector AsmVec;
-  SPIRVIdToEntryMap IdEntryMap;
+  // Entries by id. Ids below MaxDenseId, which covers any sane module, are
+  // looked up in IdEntryVec, the rest in SparseIdEntryMap. Ids come from the
+  // input, so the dense table must never be sized by them alone.
+  static constexpr SPIRVId MaxDenseId = 1u << 20;
+  SPIRVIdToEntryVec IdEntryVec;
+  std::map<SPIRVId, SPIRVEntry*> SparseIdEntryMap;
   SPIRVUnknownStructFieldMap UnknownStructFieldMap;
   SPIRVFunctionVector FuncVec;
   SPIRVVariableVec VariableVec;
@@ -335,17 +342,48 @@ private:
   SPIRVStringMap StrMap;
   SPIRVCapSet CapSet;
   SPIRVSpecConstantMap *SCMap;
-  std::map<unsigned, SPIRVTypeInt*> IntTypeMap;
-  std::map<unsigned, SPIRVConstant*> LiteralMap;
+  std::unordered_map<unsigned, SPIRVTypeInt*> IntTypeMap;
+  std::unordered_map<unsigned, SPIRVConstant*> LiteralMap;
   SPIRVAliasInstMDVec AliasInstMDVec;
   SPIRVAliasInstMDMap AliasInstMDMap;
   std::vector<SPIRVModuleProcessed*> ModuleProcessedVec;
 
   void layoutEntry(SPIRVEntry* Entry);
+  void setEntry(SPIRVId Id, SPIRVEntry* Entry) {
+    if (Id >= MaxDenseId) {
+      if (Entry)
+        SparseIdEntryMap[Id] = Entry;
+      else
+        SparseIdEntryMap.erase(Id);
+      return;
+    }
+    if (Id >= IdEntryVec.size())
+      IdEntryVec.resize(Id + 1, nullptr);
+    IdEntryVec[Id] = Entry;
+  }
+  SPIRVEntry* lookupEntry(SPIRVId Id) const {
+    if (Id < IdEntryVec.size())
+      return IdEntryVec[Id];
+    if (Id < MaxDenseId)
+      return nullptr;
+    auto Loc = SparseIdEntryMap.find(Id);
+    return Loc == SparseIdEntryMap.end() ? nullptr : Loc->second;
+  }
+  // Visit all entries with an id in increasing id order.
+  template <typename Fn> void forEachIdEntry(Fn F) const {
+    for (SPIRVEntry* Entry : IdEntryVec)
+      if (Entry)
+        F(Entry);
+    for (auto& IdEntry : SparseIdEntryMap)
+      F(IdEntry.second);
+  }
 };
 
 SPIRVModuleImpl::~SPIRVModuleImpl() {
-    for (auto I : IdEntryMap)
+    for (auto I : IdEntryVec)
+        delete I;
+
+    for (auto& I : SparseIdEntryMap)
         delete I.second;
 
     for (auto I : EntryNoId)
@@ -438,7 +476,7 @@ SPIRVModuleImpl::addEntry(SPIRVEntry *Entry) {
         }
         else
         {
-            IdEntryMap[Id] = Entry;
+            setEntry(Id, Entry);
         }
     }
     else
@@ -460,11 +498,11 @@ SPIRVModuleImpl::exist(SPIRVId Id) const {
 bool
 SPIRVModuleImpl::exist(SPIRVId Id, SPIRVEntry **Entry) const {
   IGC_ASSERT_MESSAGE(Id != SPIRVID_INVALID, "Invalid Id");
-  SPIRVIdToEntryMap::const_iterator Loc = IdEntryMap.find(Id);
-  if (Loc == IdEntryMap.end())
+  SPIRVEntry *Found = lookupEntry(Id);
+  if (!Found)
     return false;
   if (Entry)
-    *Entry = Loc->second;
+    *Entry = Found;
   return true;
 }
 
@@ -483,9 +521,9 @@ SPIRVModuleImpl::getId(SPIRVId Id, unsigned increment) {
 SPIRVEntry *
 SPIRVModuleImpl::getEntry(SPIRVId Id) const {
   IGC_ASSERT_MESSAGE(Id != SPIRVID_INVALID, "Invalid Id");
-  SPIRVIdToEntryMap::const_iterator Loc = IdEntryMap.find(Id);
-  IGC_ASSERT_EXIT_MESSAGE(Loc != IdEntryMap.end(), "Id is not in map");
-  return Loc->second;
+  SPIRVEntry *Found = lookupEntry(Id);
+  IGC_ASSERT_EXIT_MESSAGE(Found, "Id is not in map");
+  return Found;
 }
 
 void
@@ -644,13 +682,12 @@ SPIRVModuleImpl::replaceForward(SPIRVForward *Forward, SPIRVEntry *Entry) {
   SPIRVId Id = Entry->getId();
   SPIRVId ForwardId = Forward->getId();
   if (ForwardId == Id)
-    IdEntryMap[Id] = Entry;
+    setEntry(Id, Entry);
   else {
-    auto Loc = IdEntryMap.find(Id);
-    IGC_ASSERT_EXIT(Loc != IdEntryMap.end());
-    IdEntryMap.erase(Loc);
+    IGC_ASSERT_EXIT(lookupEntry(Id));
+    setEntry(Id, nullptr);
     Entry->setId(ForwardId);
-    IdEntryMap[ForwardId] = Entry;
+    setEntry(ForwardId, Entry);
   }
   // Annotations include name, decorations, execution modes
   Entry->takeAnnotations(Forward);
@@ -800,6 +837,9 @@ operator>> (std::istream &I, SPIRVModule &M) {
 
   // Bound for Id
   Decoder >> MI.NextId;
+  // Size the id table up front. The bound comes from the input, so only
+  // trust it up to the dense range, larger ids go to the sparse map.
+  MI.IdEntryVec.resize(std::min<SPIRVWord>(MI.NextId, SPIRVModuleImpl::MaxDenseId), nullptr);
 
   Decoder >> MI.InstSchema;
   IGC_ASSERT_MESSAGE(MI.InstSchema == SPIRVISCH_Default, "Unsupported instruction schema");
@@ -54,11 +54,13 @@ THE SOFTWARE.
 namespace igc_spv{
 
 SPIRVDecoder::SPIRVDecoder(std::istream &InputStream, SPIRVFunction &F)
-  :IS(InputStream), M(*F.getModule()), WordCount(0), OpCode(OpNop),
+  :IS(InputStream), Buf(SPIRVInputStream::getBuffer(InputStream)),
+   M(*F.getModule()), WordCount(0), OpCode(OpNop),
    Scope(&F){}
 
 SPIRVDecoder::SPIRVDecoder(std::istream &InputStream, SPIRVBasicBlock &BB)
-  :IS(InputStream), M(*BB.getModule()), WordCount(0), OpCode(OpNop),
+  :IS(InputStream), Buf(SPIRVInputStream::getBuffer(InputStream)),
+   M(*BB.getModule()), WordCount(0), OpCode(OpNop),
    Scope(&BB){}
 
 void
@@ -69,17 +71,19 @@ SPIRVDecoder::setScope(SPIRVEntry *TheScope) {
 }
 
 template<>
-const SPIRVDecoder& DecodeBinary(const SPIRVDecoder& I, bool &V) {
-   SPIRVWord W;
-   I.IS.read(reinterpret_cast<char*>(&W), sizeof(W));
-   V = (W == 0) ? false : true;
+const SPIRVDecoder&
+DecodeBinary(const SPIRVDecoder& I, SPIRVWord &V) {
+   if (I.Buf && I.IS.good() && I.Buf->readWord(V))
+     return I;
+   I.IS.read(reinterpret_cast<char*>(&V), sizeof(V));
    return I;
 }
 
 template<>
-const SPIRVDecoder&
-DecodeBinary(const SPIRVDecoder& I, SPIRVWord &V) {
-   I.IS.read(reinterpret_cast<char*>(&V), sizeof(V));
+const SPIRVDecoder& DecodeBinary(const SPIRVDecoder& I, bool &V) {
+   SPIRVWord W;
+   DecodeBinary(I, W);
+   V = (W == 0) ? false : true;
    return I;
 }
 
@@ -136,9 +140,14 @@ const SPIRVDecoder&
 operator>>(const SPIRVDecoder&I, std::string& Str) {
   uint64_t Count = 0;
   char Ch = '\0';
-  while ((!I.IS.eof() && I.IS.get(Ch)) && Ch != '\0') {
-    Str += Ch;
-    ++Count;
+  size_t Start = Str.size();
+  if (I.Buf && I.IS.good() && I.Buf->readString(Str)) {
+    Count = Str.size() - Start;
+  } else {
+    while ((!I.IS.eof() && I.IS.get(Ch)) && Ch != '\0') {
+      Str += Ch;
+      ++Count;
+    }
   }
   Count = (Count + 1) % 4;
   Count = Count ? 4 - Count : 0;
@@ -52,8 +52,10 @@ THE SOFTWARE.
 #include "SPIRVExtInst.h"
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <iterator>
+#include <streambuf>
 #include <vector>
 #include <string>
 
@@ -62,11 +64,82 @@ namespace igc_spv{
 class SPIRVFunction;
 class SPIRVBasicBlock;
 
+// Read-only stream over a SPIR-V binary owned by the caller. Unlike
+// std::istringstream it decodes the module in place instead of copying it.
+class SPIRVInputBuffer : public std::streambuf {
+public:
+  SPIRVInputBuffer(const char *Data, size_t Size) {
+    char *Begin = const_cast<char *>(Data);
+    setg(Begin, Begin, Begin + Size);
+  }
+
+protected:
+  pos_type seekoff(off_type Off, std::ios_base::seekdir Dir,
+                   std::ios_base::openmode Which) override {
+    if (!(Which & std::ios_base::in))
+      return pos_type(off_type(-1));
+    char *Pos = Dir == std::ios_base::beg   ? eback()
+                : Dir == std::ios_base::cur ? gptr()
+                                            : egptr();
+    if (Off < eback() - Pos || Off > egptr() - Pos)
+      return pos_type(off_type(-1));
+    Pos += Off;
+    setg(eback(), Pos, egptr());
+    return pos_type(Pos - eback());
+  }
+  pos_type seekpos(pos_type Pos, std::ios_base::openmode Which) override {
+    return seekoff(off_type(Pos), std::ios_base::beg, Which);
+  }
+
+public:
+  // Read the next word straight from the buffer. Return false, leaving the
+  // position unchanged, if less than a word is left.
+  bool readWord(SPIRVWord &W) {
+    if (egptr() - gptr() < static_cast<std::ptrdiff_t>(sizeof(W)))
+      return false;
+    std::memcpy(&W, gptr(), sizeof(W));
+    gbump(sizeof(W));
+    return true;
+  }
+
+  // Append the characters up to the next '\0' to Str and skip past it.
+  // Return false, leaving the position unchanged, if there is no '\0'.
+  bool readString(std::string &Str) {
+    auto *End = static_cast<char *>(std::memchr(gptr(), '\0', egptr() - gptr()));
+    if (!End)
+      return false;
+    Str.append(gptr(), End);
+    gbump(static_cast<int>(End - gptr() + 1));
+    return true;
+  }
+};
+
+class SPIRVInputStream : private SPIRVInputBuffer, public std::istream {
+public:
+  SPIRVInputStream(const char *Data, size_t Size)
+    : SPIRVInputBuffer(Data, Size),
+      std::istream(static_cast<SPIRVInputBuffer *>(this)) {
+    pword(bufferIndex()) = static_cast<SPIRVInputBuffer *>(this);
+  }
+
+  // Buffer the decoder reads directly from when IS is a SPIRVInputStream,
+  // nullptr otherwise.
+  static SPIRVInputBuffer *getBuffer(std::istream &IS) {
+    return static_cast<SPIRVInputBuffer *>(IS.pword(bufferIndex()));
+  }
+
+private:
+  static int bufferIndex() {
+    static const int Index = std::ios_base::xalloc();
+    return Index;
+  }
+};
+
 class SPIRVDecoder {
 public:
   SPIRVDecoder(std::istream& InputStream, SPIRVModule& Module)
-    :IS(InputStream), M(Module), WordCount(0), OpCode(OpNop),
-     Scope(NULL){}
+    :IS(InputStream), Buf(SPIRVInputStream::getBuffer(InputStream)),
+     M(Module), WordCount(0), OpCode(OpNop), Scope(NULL){}
   SPIRVDecoder(std::istream& InputStream, SPIRVFunction& F);
   SPIRVDecoder(std::istream& InputStream, SPIRVBasicBlock &BB);
 
@@ -76,6 +149,7 @@ public:
   void validate()const;
 
   std::istream &IS;
+  SPIRVInputBuffer *Buf; // Buffer of IS if words can be read from it directly
   SPIRVModule &M;
   SPIRVWord WordCount;
   Op OpCode;
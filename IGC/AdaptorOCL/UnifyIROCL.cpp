@@ -190,8 +190,8 @@ namespace IGC
 
 static void CommonOCLBasedPasses(
     OpenCLProgramContext* pContext,
-    std::unique_ptr<llvm::Module> BuiltinGenericModule,
-    std::unique_ptr<llvm::Module> BuiltinSizeModule)
+    const llvm::MemoryBuffer* BuiltinGenericBuffer,
+    const llvm::MemoryBuffer* BuiltinSizeBuffer)
 {
 #if defined( _DEBUG )
     bool brokenDebugInfo = false;
@@ -232,11 +232,6 @@ static void CommonOCLBasedPasses(
 
     StringRef dataLayout = layoutstr;
     pContext->getModule()->setDataLayout(dataLayout);
-    BuiltinGenericModule->setDataLayout(dataLayout);
-    if( BuiltinSizeModule )
-    {
-        BuiltinSizeModule->setDataLayout(dataLayout);
-    }
 
     MetaDataUtils *pMdUtils = pContext->getMetaDataUtils();
 
@@ -396,7 +391,7 @@ static void CommonOCLBasedPasses(
     mpm.add(new NamedBarriersResolution(pContext->platform.getPlatformInfo().eRenderCoreFamily));
     mpm.add(new PreBIImportAnalysis());
     mpm.add(createTimeStatsCounterPass(pContext, TIME_Unify_BuiltinImport, STATS_COUNTER_START));
-    mpm.add(createBuiltInImportPass(std::move(BuiltinGenericModule), std::move(BuiltinSizeModule)));
+    mpm.add(createBuiltInImportPass(BuiltinGenericBuffer, BuiltinSizeBuffer));
     mpm.add(createTimeStatsCounterPass(pContext, TIME_Unify_BuiltinImport, STATS_COUNTER_END));
 
     if (IGC_GET_FLAG_VALUE(AllowMem2Reg))
@@ -661,18 +656,18 @@ static void CommonOCLBasedPasses(
 
 void UnifyIROCL(
     OpenCLProgramContext* pContext,
-    std::unique_ptr<llvm::Module> BuiltinGenericModule,
-    std::unique_ptr<llvm::Module> BuiltinSizeModule)
+    const llvm::MemoryBuffer* BuiltinGenericBuffer,
+    const llvm::MemoryBuffer* BuiltinSizeBuffer)
 {
-    CommonOCLBasedPasses(pContext, std::move(BuiltinGenericModule), std::move(BuiltinSizeModule));
+    CommonOCLBasedPasses(pContext, BuiltinGenericBuffer, BuiltinSizeBuffer);
 }
 
 void UnifyIRSPIR(
     OpenCLProgramContext* pContext,
-    std::unique_ptr<llvm::Module> BuiltinGenericModule,
-    std::unique_ptr<llvm::Module> BuiltinSizeModule)
+    const llvm::MemoryBuffer* BuiltinGenericBuffer,
+    const llvm::MemoryBuffer* BuiltinSizeBuffer)
 {
-    CommonOCLBasedPasses(pContext, std::move(BuiltinGenericModule), std::move(BuiltinSizeModule));
+    CommonOCLBasedPasses(pContext, BuiltinGenericBuffer, BuiltinSizeBuffer);
 }
 
 }
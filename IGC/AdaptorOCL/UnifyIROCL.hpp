@@ -13,11 +13,11 @@ namespace IGC
 {
     void UnifyIROCL(
         OpenCLProgramContext* pContext,
-        std::unique_ptr<llvm::Module> BuiltinGenericModule,
-        std::unique_ptr<llvm::Module> BuiltinSizeModule);
+        const llvm::MemoryBuffer* BuiltinGenericBuffer,
+        const llvm::MemoryBuffer* BuiltinSizeBuffer);
 
     void UnifyIRSPIR(
         OpenCLProgramContext* pContext,
-        std::unique_ptr<llvm::Module> BuiltinGenericModule,
-        std::unique_ptr<llvm::Module> BuiltinSizeModule);
+        const llvm::MemoryBuffer* BuiltinGenericBuffer,
+        const llvm::MemoryBuffer* BuiltinSizeBuffer);
 }
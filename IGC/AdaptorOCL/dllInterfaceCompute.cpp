@@ -23,6 +23,7 @@ SPDX-License-Identifier: MIT
 
 #include "AdaptorCommon/customApi.hpp"
 #include "AdaptorOCL/OCL/LoadBuffer.h"
+#include "AdaptorOCL/OCL/KernelCache.h"
 #include "AdaptorOCL/OCL/BuiltinResource.h"
 #include "AdaptorOCL/OCL/TB/igc_tb.h"
 
@@ -55,6 +56,7 @@ SPDX-License-Identifier: MIT
 #include "AdaptorOCL/SPIRV/SPIRVconsum.h"
 #include "common/LLVMWarningsPop.hpp"
 #include "AdaptorOCL/SPIRV/libSPIRV/SPIRVModule.h"
+#include "AdaptorOCL/SPIRV/libSPIRV/SPIRVStream.h"
 #include "AdaptorOCL/SPIRV/libSPIRV/SPIRVValue.h"
 #if defined(IGC_SCALAR_USE_KHRONOS_SPIRV_TRANSLATOR)
 #include "LLVMSPIRVLib.h"
@@ -138,6 +140,8 @@ SPDX-License-Identifier: MIT
 #include <llvm/Support/Format.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/ThreadPool.h>
+#include "llvmWrapper/Support/ThreadPool.h"
 #include "common/LLVMWarningsPop.hpp"
 
 #include "IGC/Metrics/IGCMetric.h"
@@ -435,7 +439,7 @@ bool TranslateSPIRVToLLVM(
     std::string& stringErrMsg)
 {
     bool success = true;
-    std::istringstream IS(SPIRVBinary.str());
+    igc_spv::SPIRVInputStream IS(SPIRVBinary.data(), SPIRVBinary.size());
     std::unordered_map<uint32_t, uint64_t> specIDToSpecValueMap = UnpackSpecConstants(
         InputArgs.pSpecConstantsIds,
         InputArgs.pSpecConstantsValues,
@@ -467,7 +471,11 @@ bool TranslateSPIRVToLLVM(
     // Actual translation from SPIR-V to LLLVM
     success = llvm::readSpirv(Context, Opts, IS, LLVMModule, stringErrMsg);
 #else // IGC Legacy SPIRV Translator
-    success = igc_spv::ReadSPIRV(Context, IS, LLVMModule, stringErrMsg, &specIDToSpecValueMap);
+    // Only the requested kernels, if any, and what they reach get translated.
+    IGC::OpenCLProgramContext::InternalOptions internalOptions(&InputArgs);
+    const std::vector<std::string>& entryPoints = internalOptions.EntryPoints;
+    success = igc_spv::ReadSPIRV(Context, IS, LLVMModule, stringErrMsg, &specIDToSpecValueMap,
+        entryPoints.empty() ? nullptr : &entryPoints);
 #endif
 
     // Handle OpenCL Compiler Options
@@ -987,13 +995,14 @@ bool ParseInput(
     return true;
 }
 
-void RebuildGlobalAnnotations(IGC::OpenCLProgramContext& oclContext, Module* pKernelModule)
+// Keeps only the annotations of the kernels in kernelSet
+static void RebuildGlobalAnnotations(const std::set<std::string>& kernelSet, Module* pKernelModule)
 {
     auto globalAnnotations = pKernelModule->getGlobalVariable("llvm.global.annotations");
     if (!globalAnnotations) return;
 
-    auto requiresRecompilation = [&oclContext](Function* F) {
-        return oclContext.m_retryManager.kernelSet.find(F->getName().str()) != oclContext.m_retryManager.kernelSet.end();
+    auto requiresRecompilation = [&kernelSet](Function* F) {
+        return kernelSet.find(F->getName().str()) != kernelSet.end();
     };
 
     std::vector<Constant*> newGlobalAnnotations;
@@ -1028,6 +1037,11 @@ void RebuildGlobalAnnotations(IGC::OpenCLProgramContext& oclContext, Module* pKe
     GV->setSection("llvm.metadata");
 }
 
+void RebuildGlobalAnnotations(IGC::OpenCLProgramContext& oclContext, Module* pKernelModule)
+{
+    RebuildGlobalAnnotations(oclContext.m_retryManager.kernelSet, pKernelModule);
+}
+
 #if defined(IGC_SPIRV_ENABLED)
 bool ReadSpecConstantsFromSPIRV(
     std::istream& IS,
@@ -1144,6 +1158,510 @@ static void WriteSpecConstantsDump(
                    hash, "_specconst.txt");
 }
 
+// A unified module saved as bitcode along with the context state that the
+// unification passes derive from it. A try restored from it skips
+// unification, and that state is lost by clear() or on a new context.
+struct UnifiedModule
+{
+    llvm::SmallVector<char, 0> bitcode;
+    bool checkFastFlagPerInstructionInCustomUnsafeOptPass = false;
+    bool enableFunctionPointer = false;
+    bool enableSubroutine = false;
+    bool hasStackCalls = false;
+    bool hasDPEmu = false;
+    bool hasGlobalInPrivateAddressSpace = false;
+    SInstrTypes instrTypes = {};
+
+    bool empty() const { return bitcode.empty(); }
+};
+
+// Saves the module of oclContext along with its metadata and context state.
+static void SaveUnifiedModule(
+    OpenCLProgramContext& oclContext,
+    UnifiedModule& unifiedModule)
+{
+    llvm::Module* pModule = oclContext.getModule();
+    oclContext.getMetaDataUtils()->save(*oclContext.getLLVMContext());
+    serialize(*oclContext.getModuleMetaData(), pModule);
+    llvm::raw_svector_ostream OStream(unifiedModule.bitcode);
+    llvm::WriteBitcodeToFile(*pModule, OStream);
+
+    unifiedModule.checkFastFlagPerInstructionInCustomUnsafeOptPass =
+        oclContext.m_checkFastFlagPerInstructionInCustomUnsafeOptPass;
+    unifiedModule.enableFunctionPointer = oclContext.m_enableFunctionPointer;
+    unifiedModule.enableSubroutine = oclContext.m_enableSubroutine;
+    unifiedModule.hasStackCalls = oclContext.m_hasStackCalls;
+    unifiedModule.hasDPEmu = oclContext.m_hasDPEmu;
+    unifiedModule.hasGlobalInPrivateAddressSpace = oclContext.m_hasGlobalInPrivateAddressSpace;
+    unifiedModule.instrTypes = oclContext.m_instrTypes;
+}
+
+// Drops the kernels that are not in kernelSet from the module of oclContext.
+static void RemoveOtherKernels(
+    OpenCLProgramContext& oclContext,
+    Module* pKernelModule,
+    const std::set<std::string>& kernelSet)
+{
+    // Remove annotations for the kernels that are dropped
+    RebuildGlobalAnnotations(kernelSet, pKernelModule);
+
+    for (auto it = pKernelModule->getFunctionList().begin(), ie = pKernelModule->getFunctionList().end(); it != ie;)
+    {
+        Function* pFunc = &*(it++);
+        if (pFunc->getCallingConv() == llvm::CallingConv::SPIR_KERNEL &&
+            kernelSet.find(pFunc->getName().str()) == kernelSet.end())
+        {
+            IGCMetaDataHelper::removeFunction(
+                *oclContext.getMetaDataUtils(), *oclContext.getModuleMetaData(), pFunc);
+            pFunc->eraseFromParent();
+        }
+    }
+}
+
+// Sets the module saved by SaveUnifiedModule and its context state in
+// oclContext, which must have a fresh LLVMContext, keeping only the kernels in
+// kernelSet.
+static llvm::Module* RestoreUnifiedModule(
+    OpenCLProgramContext& oclContext,
+    const UnifiedModule& unifiedModule,
+    STB_TranslateOutputArgs* pOutputArgs,
+    const std::set<std::string>& kernelSet)
+{
+    llvm::MemoryBufferRef buffer(
+        llvm::StringRef(unifiedModule.bitcode.data(), unifiedModule.bitcode.size()), "unified");
+    llvm::Expected<std::unique_ptr<llvm::Module>> ModuleOrErr =
+        llvm::parseBitcodeFile(buffer, *oclContext.getLLVMContext());
+    if (llvm::Error EC = ModuleOrErr.takeError())
+    {
+        llvm::consumeError(std::move(EC));
+        SetErrorMessage("Error loading the unified module for recompilation", *pOutputArgs);
+        return nullptr;
+    }
+    llvm::Module* pKernelModule = ModuleOrErr->release();
+    oclContext.setModule(pKernelModule);
+    deserialize(*oclContext.getModuleMetaData(), pKernelModule);
+
+    oclContext.m_checkFastFlagPerInstructionInCustomUnsafeOptPass =
+        unifiedModule.checkFastFlagPerInstructionInCustomUnsafeOptPass;
+    oclContext.m_enableFunctionPointer = unifiedModule.enableFunctionPointer;
+    oclContext.m_enableSubroutine = unifiedModule.enableSubroutine;
+    oclContext.m_hasStackCalls = unifiedModule.hasStackCalls;
+    oclContext.m_hasDPEmu = unifiedModule.hasDPEmu;
+    oclContext.m_hasGlobalInPrivateAddressSpace = unifiedModule.hasGlobalInPrivateAddressSpace;
+    oclContext.m_instrTypes = unifiedModule.instrTypes;
+
+    RemoveOtherKernels(oclContext, pKernelModule, kernelSet);
+    return pKernelModule;
+}
+
+// Runs a compilation step on oclContext and reports the exceptions it throws
+// through pOutputArgs.
+template <typename StepT>
+static bool RunCompilationStep(
+    OpenCLProgramContext& oclContext,
+    STB_TranslateOutputArgs* pOutputArgs,
+    StepT step)
+{
+    try
+    {
+        return step();
+    }
+    catch (std::bad_alloc& e)
+    {
+        (void)e; // not used now
+        SetOutputMessage("IGC: Out Of Memory", *pOutputArgs);
+        return false;
+    }
+    catch (std::exception& e)
+    {
+        if (pOutputArgs->ErrorStringSize == 0 && pOutputArgs->pErrorString == nullptr)
+        {
+            std::string message = "IGC: ";
+            message += oclContext.GetErrorAndWarning();
+            message += '\n';
+            message += e.what();
+            SetErrorMessage(message.c_str(), *pOutputArgs);
+        }
+        return false;
+    }
+}
+
+// Links the builtins into the module of oclContext and unifies it. Errors are
+// reported through pOutputArgs.
+static bool UnifyProgramModule(
+    OpenCLProgramContext& oclContext,
+    unsigned PtrSzInBits,
+    STB_TranslateOutputArgs* pOutputArgs)
+{
+    // IGC has two BIF Modules:
+    //            1. kernel Module (pKernelModule)
+    //            2. BIF Modules:
+    //                 a) generic Module (BuiltinGenericModule)
+    //                 b) size Module (BuiltinSizeModule)
+    //
+    // OCL builtin types, such as clk_event_t/queue_t, etc., are struct (opaque) types. For
+    // those types, its original names are themselves; the derived names are ones with
+    // '.<digit>' appended to the original names. For example,  clk_event_t is the original
+    // name, its derived names are clk_event_t.0, clk_event_t.1, etc.
+    //
+    // When llvm reads in multiple modules, say, M0, M1, under the same llvmcontext, if both
+    // M0 and M1 has the same struct type,  M0 will have the original name and M1 the derived
+    // name for that type.  For example, clk_event_t,  M0 will have clk_event_t, while M1 will
+    // have clk_event_t.2 (number is arbitary). After linking, those two named types should be
+    // mapped to the same type, otherwise, we could have type-mismatch (for example, OCL GAS
+    // builtin_functions tests will assertion fail during inlining due to type-mismatch).  Furthermore,
+    // when linking M1 into M0 (M0 : dstModule, M1 : srcModule), the final type is the type
+    // used in M0.
+
+    // The builtin modules are loaded lazily by BIImport, and only if the
+    // builtins the program needs weren't imported by an earlier translation.
+
+    // Load the builtin module -  Generic BC
+    std::unique_ptr<llvm::MemoryBuffer> pGenericBuffer = GetGenericModuleBuffer();
+
+    if (pGenericBuffer == NULL)
+    {
+        SetErrorMessage("Error loading the Generic builtin resource", *pOutputArgs);
+        return false;
+    }
+
+    // Load the builtin module -  pointer depended
+    std::unique_ptr<llvm::MemoryBuffer> pSizeTBuffer = nullptr;
+    {
+        char ResNumber[5] = { '-' };
+        switch (PtrSzInBits)
+        {
+        case 32:
+            _snprintf_s(ResNumber, sizeof(ResNumber), 5, "#%d", OCL_BC_32);
+            break;
+        case 64:
+            _snprintf_s(ResNumber, sizeof(ResNumber), 5, "#%d", OCL_BC_64);
+            break;
+        default:
+            IGC_ASSERT_MESSAGE(0, "Unknown bitness of compiled module");
+        }
+
+        pSizeTBuffer.reset(llvm::LoadBufferFromResource(ResNumber, "BC"));
+        IGC_ASSERT_MESSAGE(pSizeTBuffer, "Error loading builtin resource");
+    }
+
+    oclContext.getModuleMetaData()->csInfo.forcedSIMDSize |= IGC_GET_FLAG_VALUE(ForceOCLSIMDWidth);
+
+    return RunCompilationStep(oclContext, pOutputArgs, [&]() {
+        if (llvm::StringRef(oclContext.getModule()->getTargetTriple()).startswith("spir"))
+        {
+            IGC::UnifyIRSPIR(&oclContext, pGenericBuffer.get(), pSizeTBuffer.get());
+        }
+        else // not SPIR
+        {
+            IGC::UnifyIROCL(&oclContext, pGenericBuffer.get(), pSizeTBuffer.get());
+        }
+
+        if (oclContext.HasError())
+        {
+            if (oclContext.HasWarning())
+            {
+                SetOutputMessage(oclContext.GetErrorAndWarning(), *pOutputArgs);
+            }
+            else
+            {
+                SetOutputMessage(oclContext.GetError(), *pOutputArgs);
+            }
+            return false;
+        }
+        return true;
+    });
+}
+
+// Unifies the module of oclContext unless isUnified is set, then optimizes it
+// and generates code for its kernels. Errors are reported through pOutputArgs.
+//
+// Linking and unification don't depend on the retry state, so when
+// pUnifiedModule is given and still empty the unified module is saved there
+// if a retry may follow. A retry then restores it with RestoreUnifiedModule
+// and starts from the optimizations.
+static bool CompileProgramModule(
+    OpenCLProgramContext& oclContext,
+    unsigned PtrSzInBits,
+    STB_TranslateOutputArgs* pOutputArgs,
+    bool isUnified,
+    UnifiedModule* pUnifiedModule = nullptr)
+{
+    IGC::TraceEventScope retryScope(
+        "Retry state " + std::to_string(oclContext.m_retryManager.GetRetryId()), "IGC");
+
+    if (!isUnified && !UnifyProgramModule(oclContext, PtrSzInBits, pOutputArgs))
+    {
+        return false;
+    }
+
+    if (pUnifiedModule && pUnifiedModule->empty() && !oclContext.m_retryManager.IsLastTry())
+    {
+        SaveUnifiedModule(oclContext, *pUnifiedModule);
+    }
+
+    return RunCompilationStep(oclContext, pOutputArgs, [&]() {
+        // Compiler Options information available after unification.
+        ModuleMetaData* modMD = oclContext.getModuleMetaData();
+        if (modMD->compOpt.DenormsAreZero)
+        {
+            oclContext.m_floatDenormMode16 = FLOAT_DENORM_FLUSH_TO_ZERO;
+            oclContext.m_floatDenormMode32 = FLOAT_DENORM_FLUSH_TO_ZERO;
+        }
+        if (IGC_GET_FLAG_VALUE(ForceFastestSIMD))
+        {
+            oclContext.m_retryManager.AdvanceState();
+            oclContext.m_retryManager.SetFirstStateId(oclContext.m_retryManager.GetRetryId());
+        }
+        // Optimize the IR. This happens once for each program, not per-kernel.
+        IGC::OptimizeIR(&oclContext);
+
+        // Now, perform code generation
+        IGC::CodeGen(&oclContext);
+        return true;
+    });
+}
+
+// A kernel of the program compiled on its own LLVMContext when
+// EnableParallelKernelCompile is set.
+struct KernelCompileJob
+{
+    std::string kernelName;
+    std::unique_ptr<OpenCLProgramContext> context;
+    STB_TranslateOutputArgs outputArgs;
+    bool success = false;
+};
+
+// Per-kernel compilation only pays off for programs with several kernels. The
+// kernels must not share program-scope state, since that could not be merged
+// back once they are compiled on separate contexts. M is the unified module:
+// it already has the globals that builtins and unification bring in, so this
+// is decided before any kernel is compiled. Program-scope data comes from
+// defined globals and from initializer and finalizer kernels, so no kernel
+// compiled on its own can end up with any.
+static bool CanCompileKernelsInParallel(
+    const OpenCLProgramContext& oclContext,
+    const llvm::Module& M)
+{
+    const auto& options = oclContext.m_InternalOptions;
+    if (options.IncludeSIPCSR ||
+        options.IncludeSIPKernelDebug ||
+        options.IncludeSIPKernelDebugWithLocalMemory ||
+        options.KernelDebugEnable ||
+        !M.debug_compile_units().empty())
+    {
+        return false;
+    }
+
+    for (const auto& GV : M.globals())
+    {
+        if (!GV.isDeclaration() && !GV.getName().startswith("llvm.") &&
+            GV.getAddressSpace() != ADDRESS_SPACE_LOCAL)
+        {
+            return false;
+        }
+    }
+
+    for (const auto& FuncMD : oclContext.getModuleMetaData()->FuncMD)
+    {
+        if (FuncMD.second.IsInitializer || FuncMD.second.IsFinalizer)
+        {
+            return false;
+        }
+    }
+
+    unsigned numKernels = 0;
+    for (const auto& F : M.functions())
+    {
+        // Function pointers need a program-wide symbol table
+        if (F.hasAddressTaken())
+        {
+            return false;
+        }
+        if (F.getCallingConv() == llvm::CallingConv::SPIR_KERNEL)
+        {
+            numKernels++;
+        }
+    }
+    return numKernels > 1;
+}
+
+static bool HasProgramScopeData(const SOpenCLProgramInfo& programInfo)
+{
+    return programInfo.m_initConstantAnnotation ||
+        programInfo.m_initConstantStringAnnotation ||
+        programInfo.m_initGlobalAnnotation ||
+        !programInfo.m_initConstantPointerAnnotation.empty() ||
+        !programInfo.m_initGlobalPointerAnnotation.empty() ||
+        !programInfo.m_initKernelTypeAnnotation.empty() ||
+        !programInfo.m_GlobalPointerAddressRelocAnnotation.globalReloc.empty() ||
+        !programInfo.m_GlobalPointerAddressRelocAnnotation.globalConstReloc.empty() ||
+        !programInfo.m_zebinSymbolTable.global.empty() ||
+        !programInfo.m_zebinSymbolTable.globalConst.empty() ||
+        !programInfo.m_zebinSymbolTable.globalStringConst.empty() ||
+        !programInfo.m_zebinGlobalHostAccessTable.empty();
+}
+
+// Runs on a worker thread, mirrors the whole-program flow of TranslateBuildSPMD
+// for a single kernel of the unified module.
+static void CompileKernelJob(
+    KernelCompileJob& job,
+    const OpenCLProgramContext& programContext,
+    const UnifiedModule& unifiedModule,
+    const STB_TranslateInputArgs* pInputArgs,
+    unsigned PtrSzInBits)
+{
+    job.context.reset(new OpenCLProgramContext(
+        static_cast<const COCLBTILayout&>(programContext.btiLayout),
+        programContext.platform,
+        pInputArgs,
+        programContext.m_DriverInfo));
+    OpenCLProgramContext& oclContext = *job.context;
+    IGC::Debug::RegisterComputeErrHandlers(*oclContext.getLLVMContext());
+
+    oclContext.m_ProfilingTimerResolution = programContext.m_ProfilingTimerResolution;
+    if (programContext.isSPIRV())
+    {
+        oclContext.setAsSPIRV();
+    }
+    oclContext.gtpin_init = programContext.gtpin_init;
+    // Dumps and other data keyed by the shader hash must tell the kernels
+    // apart. The program hashes are kept, and only the per-shader hash of this
+    // kernel's context is derived from its name.
+    oclContext.hash = programContext.hash;
+    oclContext.hash.perShaderPsoHash = programContext.hash.getPerShaderPsoHash() ^
+        iSTD::HashFromBuffer(job.kernelName.data(), job.kernelName.size());
+    oclContext.annotater = nullptr;
+    oclContext.m_floatDenormMode16 = programContext.m_floatDenormMode16;
+    oclContext.m_floatDenormMode32 = programContext.m_floatDenormMode32;
+    oclContext.m_floatDenormMode64 = programContext.m_floatDenormMode64;
+
+    std::set<std::string> kernelSet = { job.kernelName };
+    bool retry = false;
+    oclContext.m_retryManager.Enable(ShaderType::OPENCL_SHADER);
+    if (oclContext.m_InternalOptions.DisableRecompilation)
+    {
+        oclContext.m_retryManager.Disable(true);
+    }
+    do
+    {
+        // Every try starts over from the unified module and its metadata
+        if (!RestoreUnifiedModule(oclContext, unifiedModule, &job.outputArgs, kernelSet))
+        {
+            return;
+        }
+        if (!retry)
+        {
+            oclContext.metrics.Init(&oclContext.hash,
+                oclContext.getModule()->getNamedMetadata("llvm.dbg.cu") != nullptr);
+            oclContext.metrics.CollectFunctions(oclContext.getModule());
+        }
+
+        if (!CompileProgramModule(oclContext, PtrSzInBits, &job.outputArgs, true))
+        {
+            return;
+        }
+
+        retry = (!oclContext.m_retryManager.kernelSet.empty() &&
+                 oclContext.m_retryManager.AdvanceState());
+
+        if (retry)
+        {
+            kernelSet = oclContext.m_retryManager.kernelSet;
+            oclContext.clearBeforeRetry();
+            oclContext.clear();
+
+            // Create a new LLVMContext
+            oclContext.initLLVMContextWrapper();
+
+            IGC::Debug::RegisterComputeErrHandlers(*oclContext.getLLVMContext());
+        }
+    } while (retry);
+
+    oclContext.failOnSpills();
+    job.success = true;
+}
+
+// Compiles every kernel of the program on its own context on a thread pool and
+// moves the resulting shader programs into oclContext. The module of oclContext
+// must be unified and accepted by CanCompileKernelsInParallel.
+static bool CompileKernelsInParallel(
+    OpenCLProgramContext& oclContext,
+    std::vector<KernelCompileJob>& jobs,
+    const STB_TranslateInputArgs* pInputArgs,
+    STB_TranslateOutputArgs* pOutputArgs,
+    unsigned PtrSzInBits)
+{
+    for (const auto& F : oclContext.getModule()->functions())
+    {
+        if (F.getCallingConv() == llvm::CallingConv::SPIR_KERNEL)
+        {
+            jobs.emplace_back();
+            jobs.back().kernelName = F.getName().str();
+        }
+    }
+
+    // Modules can't be moved across LLVMContexts, so each worker takes its
+    // kernel from the unified module saved as bitcode.
+    UnifiedModule unifiedModule;
+    SaveUnifiedModule(oclContext, unifiedModule);
+
+    {
+        std::unique_ptr<llvm::ThreadPool> pool =
+            IGCLLVM::createThreadPool(IGC_GET_FLAG_VALUE(ParallelKernelCompileThreads));
+        for (auto& job : jobs)
+        {
+            pool->async([&job, &oclContext, &unifiedModule, pInputArgs, PtrSzInBits]() {
+                CompileKernelJob(job, oclContext, unifiedModule, pInputArgs, PtrSzInBits);
+            });
+        }
+        pool->wait();
+    }
+
+    bool success = true;
+    for (auto& job : jobs)
+    {
+        // Report the first failing kernel
+        if (!job.success && success)
+        {
+            success = false;
+            if (job.outputArgs.pErrorString)
+            {
+                SetOutputMessage(job.outputArgs.pErrorString, *pOutputArgs);
+            }
+        }
+        delete[] job.outputArgs.pErrorString;
+        job.outputArgs.pErrorString = nullptr;
+    }
+    if (!success)
+    {
+        return false;
+    }
+
+    for (const auto& job : jobs)
+    {
+        IGC_ASSERT_MESSAGE(!HasProgramScopeData(job.context->m_programInfo),
+            "CanCompileKernelsInParallel let through program-scope data");
+    }
+
+    for (auto& job : jobs)
+    {
+        OpenCLProgramContext& kernelContext = *job.context;
+        oclContext.AppendDiagnostics(kernelContext);
+
+        auto& shaderPrograms = kernelContext.m_programOutput.m_ShaderProgramList;
+        std::move(shaderPrograms.begin(), shaderPrograms.end(),
+            std::back_inserter(oclContext.m_programOutput.m_ShaderProgramList));
+        shaderPrograms.clear();
+
+        oclContext.m_programInfo.m_hasCrossThreadOffsetRelocations =
+            oclContext.m_programInfo.m_hasCrossThreadOffsetRelocations ||
+            kernelContext.m_programInfo.m_hasCrossThreadOffsetRelocations;
+    }
+
+    return true;
+}
+
 bool TranslateBuildSPMD(
     const STB_TranslateInputArgs* pInputArgs,
     STB_TranslateOutputArgs* pOutputArgs,
@@ -1265,6 +1783,9 @@ bool TranslateBuildSPMD(
 
     USC::SShaderStageBTLayout zeroLayout = USC::g_cZeroShaderStageBTLayout;
     IGC::COCLBTILayout oclLayout(&zeroLayout);
+    // Shader programs of kernels compiled in parallel are moved into oclContext
+    // but still refer to their own contexts, so those must outlive it.
+    std::vector<KernelCompileJob> kernelJobs;
     OpenCLProgramContext oclContext(oclLayout, IGCPlatform, pInputArgs, *driverInfo, llvmContext);
 
 #ifdef __GNUC__
@@ -1314,240 +1835,125 @@ bool TranslateBuildSPMD(
 
     bool doSplitModule = oclContext.m_InternalOptions.CompileOneKernelAtTime ||
                          IGC_IS_FLAG_ENABLED(CompileOneAtTime);
-    // set retry manager
-    bool retry = false;
-    oclContext.m_retryManager.Enable(ShaderType::OPENCL_SHADER);
-    do
+
+    // Whether kernels can be compiled in parallel depends on the unified
+    // module. If they can't, the whole-program flow continues from it.
+    bool isUnified = false;
+    bool compiledPerKernel = false;
+    if (!doSplitModule && IGC_IS_FLAG_ENABLED(EnableParallelKernelCompile) && oclContext.enableZEBinary())
     {
-        llvm::TinyPtrVector<const llvm::Function*> kernelFunctions;
-        if (doSplitModule)
+        if (!UnifyProgramModule(oclContext, PtrSzInBits, pOutputArgs))
         {
-            for (const auto& F : pKernelModule->functions())
-            {
-                if (F.getCallingConv() == llvm::CallingConv::SPIR_KERNEL)
-                {
-                    kernelFunctions.push_back(&F);
-                }
-            }
+            return false;
+        }
+        isUnified = true;
 
-            if (retry)
+        if (CanCompileKernelsInParallel(oclContext, *oclContext.getModule()))
+        {
+            if (!CompileKernelsInParallel(oclContext, kernelJobs, pInputArgs, pOutputArgs, PtrSzInBits))
             {
-                fprintf(stderr, "IGC recompiles whole module with different optimization strategy, recompiling all kernels \n");
+                return false;
             }
-            IGC_ASSERT_EXIT_MESSAGE(kernelFunctions.empty() == false, "No kernels found!");
-            fprintf(stderr, "IGC compiles kernels one by one... (%d total)\n", kernelFunctions.size());
+            compiledPerKernel = true;
         }
+    }
 
-        // for Module splitting feature; if it's inactive, flow is as normal
-        do {
-            KernelModuleSplitter splitter(oclContext, *pKernelModule);
+    if (!compiledPerKernel)
+    {
+        // Split modules are dropped after each kernel, so retries of those
+        // start over from the input.
+        UnifiedModule unifiedModule;
+        UnifiedModule* pUnifiedModule =
+            (!doSplitModule && IGC_IS_FLAG_ENABLED(EnableRetryFromUnifiedModule)) ? &unifiedModule : nullptr;
+
+        // set retry manager
+        bool retry = false;
+        oclContext.m_retryManager.Enable(ShaderType::OPENCL_SHADER);
+        if (oclContext.m_InternalOptions.DisableRecompilation)
+        {
+            oclContext.m_retryManager.Disable(true);
+        }
+        do
+        {
+            llvm::TinyPtrVector<const llvm::Function*> kernelFunctions;
             if (doSplitModule)
             {
-                const llvm::Function* pKernelFunction = kernelFunctions.back();
-
-                fprintf(stderr, "Compiling kernel #%d: %s\n", kernelFunctions.size(), pKernelFunction->getName().data());
-                kernelFunctions.pop_back();
-
-                splitter.splitModuleForKernel(pKernelFunction);
-                splitter.setSplittedModuleInOCLContext();
-            }
-
-            std::unique_ptr<llvm::Module> BuiltinGenericModule = nullptr;
-            std::unique_ptr<llvm::Module> BuiltinSizeModule = nullptr;
-            std::unique_ptr<llvm::MemoryBuffer> pGenericBuffer = nullptr;
-            std::unique_ptr<llvm::MemoryBuffer> pSizeTBuffer = nullptr;
-            {
-                // IGC has two BIF Modules:
-                //            1. kernel Module (pKernelModule)
-                //            2. BIF Modules:
-                //                 a) generic Module (BuiltinGenericModule)
-                //                 b) size Module (BuiltinSizeModule)
-                //
-                // OCL builtin types, such as clk_event_t/queue_t, etc., are struct (opaque) types. For
-                // those types, its original names are themselves; the derived names are ones with
-                // '.<digit>' appended to the original names. For example,  clk_event_t is the original
-                // name, its derived names are clk_event_t.0, clk_event_t.1, etc.
-                //
-                // When llvm reads in multiple modules, say, M0, M1, under the same llvmcontext, if both
-                // M0 and M1 has the same struct type,  M0 will have the original name and M1 the derived
-                // name for that type.  For example, clk_event_t,  M0 will have clk_event_t, while M1 will
-                // have clk_event_t.2 (number is arbitary). After linking, those two named types should be
-                // mapped to the same type, otherwise, we could have type-mismatch (for example, OCL GAS
-                // builtin_functions tests will assertion fail during inlining due to type-mismatch).  Furthermore,
-                // when linking M1 into M0 (M0 : dstModule, M1 : srcModule), the final type is the type
-                // used in M0.
-
-                // Load the builtin module -  Generic BC
-                // Load the builtin module -  Generic BC
+                for (const auto& F : pKernelModule->functions())
                 {
-                    COMPILER_TIME_START(&oclContext, TIME_OCL_LazyBiFLoading);
-
-                    pGenericBuffer = GetGenericModuleBuffer();
-
-                    if (pGenericBuffer == NULL)
-                    {
-                        SetErrorMessage("Error loading the Generic builtin resource", *pOutputArgs);
-                        return false;
-                    }
-
-                    llvm::Expected<std::unique_ptr<llvm::Module>> ModuleOrErr =
-                        getLazyBitcodeModule(pGenericBuffer->getMemBufferRef(), *oclContext.getLLVMContext());
-
-                    if (llvm::Error EC = ModuleOrErr.takeError())
+                    if (F.getCallingConv() == llvm::CallingConv::SPIR_KERNEL)
                     {
-                        std::string error_str = "Error lazily loading bitcode for generic builtins,"
-                                                "is bitcode the right version and correctly formed?";
-                        SetErrorMessage(error_str, *pOutputArgs);
-                        return false;
-                    }
-                    else
-                    {
-                        BuiltinGenericModule = std::move(*ModuleOrErr);
-                    }
-
-                    if (BuiltinGenericModule == NULL)
-                    {
-                        SetErrorMessage("Error loading the Generic builtin module from buffer", *pOutputArgs);
-                        return false;
+                        kernelFunctions.push_back(&F);
                     }
-                    COMPILER_TIME_END(&oclContext, TIME_OCL_LazyBiFLoading);
                 }
 
-                // Load the builtin module -  pointer depended
+                if (retry)
                 {
-                    char ResNumber[5] = { '-' };
-                    switch (PtrSzInBits)
-                    {
-                    case 32:
-                        _snprintf_s(ResNumber, sizeof(ResNumber), 5, "#%d", OCL_BC_32);
-                        break;
-                    case 64:
-                        _snprintf_s(ResNumber, sizeof(ResNumber), 5, "#%d", OCL_BC_64);
-                        break;
-                    default:
-                        IGC_ASSERT_MESSAGE(0, "Unknown bitness of compiled module");
-                    }
-
-                    // the MemoryBuffer becomes owned by the module and does not need to be managed
-                    pSizeTBuffer.reset(llvm::LoadBufferFromResource(ResNumber, "BC"));
-                    IGC_ASSERT_MESSAGE(pSizeTBuffer, "Error loading builtin resource");
-
-                    llvm::Expected<std::unique_ptr<llvm::Module>> ModuleOrErr =
-                        getLazyBitcodeModule(pSizeTBuffer->getMemBufferRef(), *oclContext.getLLVMContext());
-                    if (llvm::Error EC = ModuleOrErr.takeError())
-                        IGC_ASSERT_MESSAGE(0, "Error lazily loading bitcode for size_t builtins");
-                    else
-                        BuiltinSizeModule = std::move(*ModuleOrErr);
-
-                    IGC_ASSERT_MESSAGE(BuiltinSizeModule, "Error loading builtin module from buffer");
+                    fprintf(stderr, "IGC recompiles whole module with different optimization strategy, recompiling all kernels \n");
                 }
-
-                BuiltinGenericModule->setDataLayout(BuiltinSizeModule->getDataLayout());
-                BuiltinGenericModule->setTargetTriple(BuiltinSizeModule->getTargetTriple());
+                IGC_ASSERT_EXIT_MESSAGE(kernelFunctions.empty() == false, "No kernels found!");
+                fprintf(stderr, "IGC compiles kernels one by one... (%d total)\n", kernelFunctions.size());
             }
 
-            oclContext.getModuleMetaData()->csInfo.forcedSIMDSize |= IGC_GET_FLAG_VALUE(ForceOCLSIMDWidth);
-
-            try
-            {
-                if (llvm::StringRef(oclContext.getModule()->getTargetTriple()).startswith("spir"))
-                {
-                    IGC::UnifyIRSPIR(&oclContext, std::move(BuiltinGenericModule), std::move(BuiltinSizeModule));
-                }
-                else // not SPIR
+            // for Module splitting feature; if it's inactive, flow is as normal
+            do {
+                KernelModuleSplitter splitter(oclContext, *pKernelModule);
+                if (doSplitModule)
                 {
-                    IGC::UnifyIROCL(&oclContext, std::move(BuiltinGenericModule), std::move(BuiltinSizeModule));
-                }
+                    const llvm::Function* pKernelFunction = kernelFunctions.back();
 
-                if (oclContext.HasError())
-                {
-                    if (oclContext.HasWarning())
-                    {
-                        SetOutputMessage(oclContext.GetErrorAndWarning(), *pOutputArgs);
-                    }
-                    else
-                    {
-                        SetOutputMessage(oclContext.GetError(), *pOutputArgs);
-                    }
-                    return false;
-                }
+                    fprintf(stderr, "Compiling kernel #%d: %s\n", kernelFunctions.size(), pKernelFunction->getName().data());
+                    kernelFunctions.pop_back();
 
-                // Compiler Options information available after unification.
-                ModuleMetaData* modMD = oclContext.getModuleMetaData();
-                if (modMD->compOpt.DenormsAreZero)
-                {
-                    oclContext.m_floatDenormMode16 = FLOAT_DENORM_FLUSH_TO_ZERO;
-                    oclContext.m_floatDenormMode32 = FLOAT_DENORM_FLUSH_TO_ZERO;
+                    splitter.splitModuleForKernel(pKernelFunction);
+                    splitter.setSplittedModuleInOCLContext();
                 }
-                if (IGC_GET_FLAG_VALUE(ForceFastestSIMD))
-                {
-                    oclContext.m_retryManager.AdvanceState();
-                    oclContext.m_retryManager.SetFirstStateId(oclContext.m_retryManager.GetRetryId());
-                }
-                // Optimize the IR. This happens once for each program, not per-kernel.
-                IGC::OptimizeIR(&oclContext);
 
-                // Now, perform code generation
-                IGC::CodeGen(&oclContext);
-            }
-            catch (std::bad_alloc& e)
-            {
-                (void)e; // not used now
-                SetOutputMessage("IGC: Out Of Memory", *pOutputArgs);
-                return false;
-            }
-            catch (std::exception& e)
-            {
-                if (pOutputArgs->ErrorStringSize == 0 && pOutputArgs->pErrorString == nullptr)
+                if (!CompileProgramModule(oclContext, PtrSzInBits, pOutputArgs, isUnified, pUnifiedModule))
                 {
-                    std::string message = "IGC: ";
-                    message += oclContext.GetErrorAndWarning();
-                    message += '\n';
-                    message += e.what();
-                    SetErrorMessage(message.c_str(), *pOutputArgs);
+                    return false;
                 }
-                return false;
-            }
-
-            retry = (!oclContext.m_retryManager.kernelSet.empty() &&
-                     oclContext.m_retryManager.AdvanceState());
-
-            if (retry)
-            {
-                splitter.retry();
-                kernelFunctions.clear();
-                oclContext.clearBeforeRetry();
-                oclContext.clear();
-
-                // Create a new LLVMContext
-                oclContext.initLLVMContextWrapper();
 
-                IGC::Debug::RegisterComputeErrHandlers(*oclContext.getLLVMContext());
+                retry = (!oclContext.m_retryManager.kernelSet.empty() &&
+                         oclContext.m_retryManager.AdvanceState());
 
-                if (!ParseInput(pKernelModule, pInputArgs, pOutputArgs, *oclContext.getLLVMContext(), inputDataFormatTemp))
+                if (retry)
                 {
-                    return false;
-                }
-                oclContext.setModule(pKernelModule);
+                    splitter.retry();
+                    kernelFunctions.clear();
+                    oclContext.clearBeforeRetry();
+                    oclContext.clear();
 
-                // Remove annotations for kernels that do not require recompilation
-                RebuildGlobalAnnotations(oclContext, pKernelModule);
+                    // Create a new LLVMContext
+                    oclContext.initLLVMContextWrapper();
 
-                for (auto it = pKernelModule->getFunctionList().begin(), ie = pKernelModule->getFunctionList().end(); it != ie;)
-                {
-                    Function* pFunc = &*(it++);
-                    // Only retry compilation on kernels that need it
-                    if (pFunc->getCallingConv() == llvm::CallingConv::SPIR_KERNEL &&
-                        oclContext.m_retryManager.kernelSet.find(pFunc->getName().str()) == oclContext.m_retryManager.kernelSet.end())
+                    IGC::Debug::RegisterComputeErrHandlers(*oclContext.getLLVMContext());
+
+                    isUnified = !unifiedModule.empty();
+                    if (isUnified)
+                    {
+                        pKernelModule = RestoreUnifiedModule(
+                            oclContext, unifiedModule, pOutputArgs, oclContext.m_retryManager.kernelSet);
+                        if (!pKernelModule)
+                        {
+                            return false;
+                        }
+                    }
+                    else
                     {
-                        pFunc->eraseFromParent();
+                        if (!ParseInput(pKernelModule, pInputArgs, pOutputArgs, *oclContext.getLLVMContext(), inputDataFormatTemp))
+                        {
+                            return false;
+                        }
+                        oclContext.setModule(pKernelModule);
+                        // Only retry compilation on kernels that need it
+                        RemoveOtherKernels(oclContext, pKernelModule, oclContext.m_retryManager.kernelSet);
                     }
                 }
-            }
-        } while (!kernelFunctions.empty());
-    } while (retry);
+            } while (!kernelFunctions.empty());
+        } while (retry);
 
-    oclContext.failOnSpills();
+        oclContext.failOnSpills();
+    }
 
     if (oclContext.HasError())
     {
@@ -1591,8 +1997,7 @@ bool TranslateBuildSPMD(
     else
     {
         // ze binary foramt
-        llvm::SmallVector<char, 64> buf;
-        llvm::raw_svector_ostream llvm_os(buf);
+        std::unique_ptr<char[]> zeBinary;
         const bool excludeIRFromZEBinary = IGC_IS_FLAG_ENABLED(ExcludeIRFromZEBinary) || oclContext.getModuleMetaData()->compOpt.ExcludeIRFromZEBinary;
         const char* spv_data = nullptr;
         uint32_t spv_size = 0;
@@ -1606,13 +2011,9 @@ bool TranslateBuildSPMD(
         size_t metricDataSize = oclContext.metrics.getMetricDataSize();
         auto metricData = reinterpret_cast<const char*>(oclContext.metrics.getMetricData());
 
-        oclContext.m_programOutput.GetZEBinary(llvm_os, pointerSizeInBytes,
+        oclContext.m_programOutput.GetZEBinary(zeBinary, binarySize, pointerSizeInBytes,
             spv_data, spv_size, metricData, metricDataSize, pInputArgs->pOptions, pInputArgs->OptionsSize);
-
-        // FIXME: try to avoid memory copy here
-        binarySize = buf.size();
-        binaryOutput = new char[binarySize];
-        memcpy_s(binaryOutput, binarySize, buf.data(), buf.size());
+        binaryOutput = zeBinary.release();
     }
 
     if (IGC_IS_FLAG_ENABLED(ShaderDumpEnable))
@@ -1672,6 +2073,45 @@ bool TranslateBuildVC(
 }
 #endif // defined(IGC_VC_ENABLED)
 
+// Dispatches a build to the VC, SPMD or mixed SPMD+ESIMD flow
+static bool TranslateBuildForInput(
+    const STB_TranslateInputArgs* pInputArgs,
+    STB_TranslateOutputArgs* pOutputArgs,
+    TB_DATA_FORMAT inputDataFormatTemp,
+    const IGC::CPlatform& IGCPlatform,
+    float profilingTimerResolution,
+    const ShaderHash& inputShHash)
+{
+#if defined(IGC_VC_ENABLED)
+    // if VC option was specified, go to VC compilation directly.
+    if (pInputArgs->pOptions && (strstr(pInputArgs->pOptions, "-vc-codegen") ||
+                                 strstr(pInputArgs->pOptions, "-cmc")))
+    {
+        return TranslateBuildVC(pInputArgs, pOutputArgs, inputDataFormatTemp,
+                                IGCPlatform, profilingTimerResolution,
+                                inputShHash);
+    }
+#endif // defined(IGC_VC_ENABLED)
+
+    if (inputDataFormatTemp != TB_DATA_FORMAT_SPIR_V)
+    {
+        return TranslateBuildSPMD(pInputArgs, pOutputArgs, inputDataFormatTemp,
+                                  IGCPlatform, profilingTimerResolution,
+                                  inputShHash);
+    }
+
+    // Recognize if SPIR-V module contains SPMD,ESIMD or SPMD+ESIMD code and compile it.
+    std::string errorMessage;
+    bool ret = VLD::TranslateBuildSPMDAndESIMD(
+        pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform,
+        profilingTimerResolution, inputShHash, errorMessage);
+    if (!ret && !errorMessage.empty())
+    {
+        SetErrorMessage(errorMessage, *pOutputArgs);
+    }
+    return ret;
+}
+
 bool TranslateBuild(
     const STB_TranslateInputArgs* pInputArgs,
     STB_TranslateOutputArgs* pOutputArgs,
@@ -1707,6 +2147,8 @@ bool TranslateBuild(
     // set g_CurrentShaderHash in igc_regkeys.cpp
     SetCurrentDebugHash(inputShHash);
 
+    IGC::TraceEventsOutput traceEventsOutput;
+
     // on wrong spec constants, vc::translateBuild may fail
     // so lets dump those early
     if (pInputArgs->SpecConstantsSize > 0 && IGC_IS_FLAG_ENABLED(ShaderDumpEnable))
@@ -1714,34 +2156,21 @@ bool TranslateBuild(
         WriteSpecConstantsDump(pInputArgs, inputShHash.getAsmHash());
     }
 
-#if defined(IGC_VC_ENABLED)
-    // if VC option was specified, go to VC compilation directly.
-    if (pInputArgs->pOptions && (strstr(pInputArgs->pOptions, "-vc-codegen") ||
-                                 strstr(pInputArgs->pOptions, "-cmc")))
-    {
-        return TranslateBuildVC(pInputArgs, pOutputArgs, inputDataFormatTemp,
-                                IGCPlatform, profilingTimerResolution,
-                                inputShHash);
-    }
-#endif // defined(IGC_VC_ENABLED)
-
-    if (inputDataFormatTemp != TB_DATA_FORMAT_SPIR_V)
+    const std::string cacheKey = KernelCache::GetKey(
+        pInputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution);
+    if (!cacheKey.empty() && KernelCache::Load(cacheKey, *pOutputArgs))
     {
-        return TranslateBuildSPMD(pInputArgs, pOutputArgs, inputDataFormatTemp,
-                                  IGCPlatform, profilingTimerResolution,
-                                  inputShHash);
+        return true;
     }
 
-    // Recognize if SPIR-V module contains SPMD,ESIMD or SPMD+ESIMD code and compile it.
-    std::string errorMessage;
-    bool ret = VLD::TranslateBuildSPMDAndESIMD(
-        pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform,
-        profilingTimerResolution, inputShHash, errorMessage);
-    if (!ret && !errorMessage.empty())
+    bool success = TranslateBuildForInput(pInputArgs, pOutputArgs, inputDataFormatTemp,
+                                          IGCPlatform, profilingTimerResolution,
+                                          inputShHash);
+    if (success && !cacheKey.empty())
     {
-        SetErrorMessage(errorMessage, *pOutputArgs);
+        KernelCache::Store(cacheKey, *pOutputArgs);
     }
-    return ret;
+    return success;
 }
 
 bool CIGCTranslationBlock::FreeAllocations(STB_TranslateOutputArgs* pOutputArgs)
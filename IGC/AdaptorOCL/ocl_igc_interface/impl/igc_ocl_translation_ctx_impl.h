@@ -21,6 +21,7 @@ SPDX-License-Identifier: MIT
 #include "ocl_igc_interface/impl/ocl_translation_output_impl.h"
 
 #include "AdaptorOCL/OCL/TB/igc_tb.h"
+#include "AdaptorOCL/SPIRV/libSPIRV/SPIRVStream.h"
 #include "common/debug/Debug.hpp"
 
 #include "cif/macros/enable.h"
@@ -181,8 +182,7 @@ CIF_DECLARE_INTERFACE_PIMPL(IgcOclTranslationCtx) : CIF::PimplBase
                 spvTextDestroy(spirvAsm);
 #endif // defined(IGC_SPIRV_TOOLS_ENABLED)
             }
-            llvm::StringRef strInput = llvm::StringRef(pInput, inputSize);
-            std::istringstream IS(strInput.str());
+            igc_spv::SPIRVInputStream IS(pInput, inputSize);
 
             // vector of pairs [spec_id, spec_size]
             std::vector<std::pair<uint32_t, uint32_t>> SCInfo;
@@ -390,7 +390,8 @@ CIF_DECLARE_INTERFACE_PIMPL(IgcOclTranslationCtx) : CIF::PimplBase
         if(success){
             dataCopiedSuccessfuly &= outputInterface->GetImpl()->AddWarning(output.pErrorString, output.ErrorStringSize);
             dataCopiedSuccessfuly &= outputInterface->GetImpl()->CloneDebugData(output.pDebugData, output.DebugDataSize);
-            dataCopiedSuccessfuly &= outputInterface->GetImpl()->SetSuccessfulAndCloneOutput(output.pOutput, output.OutputSize);
+            // The output binary is handed over as is, it can be large.
+            dataCopiedSuccessfuly &= outputInterface->GetImpl()->SetSuccessfulAndTakeOutput(outputData.release(), output.OutputSize);
         }else{
             dataCopiedSuccessfuly &= outputInterface->GetImpl()->SetError(TranslationErrorType::FailedCompilation, output.pErrorString);
         }
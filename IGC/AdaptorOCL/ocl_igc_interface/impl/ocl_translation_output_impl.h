@@ -123,12 +123,25 @@ CIF_DECLARE_INTERFACE_PIMPL(OclTranslationOutput) : CIF::PimplBase
         return Output->PushBackRawBytes(data, size);
     }
 
+    // Takes ownership of data, which must have been allocated with new char[]
+    bool SetSuccessfulAndTakeOutput(char * data, size_t size)
+    {
+        this->Error = TranslationErrorType::Success;
+        Output->SetUnderlyingStorage(data, size, &DeleteCharArray);
+        return true;
+    }
+
     bool CloneDebugData(const char * data, size_t size)
     {
         return DebugData->PushBackRawBytes(data, size);
     }
 
 protected:
+    static void CIF_CALLING_CONV DeleteCharArray(void * memory)
+    {
+        delete[] static_cast<char *>(memory);
+    }
+
     CIF::Multiversion<CIF::Builtins::Buffer> BuildLog;
     CIF::Multiversion<CIF::Builtins::Buffer> Output;
     CIF::Multiversion<CIF::Builtins::Buffer> DebugData;
@@ -21,6 +21,7 @@ SPDX-License-Identifier: MIT
 #include "common/shaderOverride.hpp"
 #include "inc/common/sku_wa.h"
 #include <llvm/Support/Path.h>
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/ADT/Statistic.h>
 #include <iStdLib/utility.h>
 #include <iostream>
@@ -4689,12 +4690,12 @@ namespace IGC
         {
             SaveOption(vISA_AvoidUsingR0R1, true);
         }
-        if (IGC_IS_FLAG_ENABLED(FastCompileRA)
+        if ((IGC_IS_FLAG_ENABLED(FastCompileRA) || context->m_ForceFastCompileRA)
             && (!hasStackCall || IGC_IS_FLAG_ENABLED(PartitionWithFastHybridRA)))
         {
             SaveOption(vISA_FastCompileRA, true);
         }
-        if (IGC_IS_FLAG_ENABLED(HybridRAWithSpill)
+        if ((IGC_IS_FLAG_ENABLED(HybridRAWithSpill) || context->m_ForceHybridRAWithSpill)
             && (!hasStackCall || IGC_IS_FLAG_ENABLED(PartitionWithFastHybridRA)))
         {
             SaveOption(vISA_HybridRAWithSpill, true);
@@ -4703,6 +4704,10 @@ namespace IGC
         {
            SaveOption(vISA_SelectiveFastRA, true);
         }
+        if (IGC_GET_FLAG_VALUE(CompileTimeBudgetMs) != 0)
+        {
+            SaveOption(vISA_CompileTimeBudget, IGC_GET_FLAG_VALUE(CompileTimeBudgetMs));
+        }
         if (IGC_IS_FLAG_ENABLED(PartitionWithFastHybridRA))
         {
             SaveOption(vISA_PartitionWithFastHybridRA, true);
@@ -5205,6 +5210,9 @@ namespace IGC
         m_enableVISAdump = false;
         m_nestLevelForcedNoMaskRegion = 0;
         m_hasInlineAsm = hasInlineAsmCall;
+        m_mergeInlineAsm = (m_hasInlineAsm || hasAdditionalVisaAsmToLink) &&
+            IGC_IS_FLAG_ENABLED(EnableInlineVISAAsmMerge);
+        m_inlineAsmParseError = false;
 
         InitLabelMap(m_program->entry);
 
@@ -5216,7 +5224,7 @@ namespace IGC
 
         llvm::SmallVector<const char*, 10> params;
         llvm::SmallVector<std::unique_ptr< char, std::function<void(char*)>>, 10> params2;
-        if (!m_hasInlineAsm)
+        if (!m_hasInlineAsm || m_mergeInlineAsm)
         {
             // Asm text writer mode doesnt need dump params
             InitBuildParams(params2);
@@ -5231,7 +5239,11 @@ namespace IGC
             IGC_IS_FLAG_ENABLED(EnableVISASlowpath) ||
             IGC_IS_FLAG_ENABLED(ShaderDumpEnable) ||
             context->getCompilerOption().EmitZeBinVISASections;
-        auto builderMode = m_hasInlineAsm || hasAdditionalVisaAsmToLink ? vISA_ASM_WRITER : vISA_DEFAULT;
+        // Inline asm is either parsed into the in-memory kernel as it is
+        // emitted, or the whole kernel is written as text to be parsed again
+        // along with inline asm at compile time.
+        auto builderMode = (m_hasInlineAsm || hasAdditionalVisaAsmToLink) && !m_mergeInlineAsm ?
+            vISA_ASM_WRITER : vISA_DEFAULT;
 
         // Build options. If in Debug mode, always enable VISA IR
         auto builderOpt = (enableVISADump || m_hasInlineAsm || hasAdditionalVisaAsmToLink) ? VISA_BUILDER_BOTH : VISA_BUILDER_GEN;
@@ -5261,6 +5273,15 @@ namespace IGC
 
         // Pass all build options to builder
         SetBuilderOptions(vbuilder);
+        if (m_mergeInlineAsm)
+        {
+            // Must be set before the kernel is added so that all its variables
+            // can be referred to by name
+            vbuilder->SetOption(vISA_MergeInlineAsm, true);
+            // Verify user asm as the text path does. Parsing additional asm
+            // to link verifies the whole builder, otherwise Compile does.
+            vbuilder->SetOption(vISA_NoVerifyvISA, hasAdditionalVisaAsmToLink);
+        }
 
         vKernel = nullptr;
 
@@ -6057,27 +6078,12 @@ namespace IGC
                 }
 
                 if (result == 0) {
-                    // Mark invoke_simd targets with LTO_InvokeOptTarget attribute.
-                    IGC_ASSERT(m_program && m_program->GetContext() &&
-                               m_program->GetContext()->getModule());
-                    for (auto &F : m_program->GetContext()->getModule()->getFunctionList()) {
-                        if (F.hasFnAttribute("invoke_simd_target")) {
-                            auto vFunc = vAsmTextBuilder->GetVISAKernel(F.getName().data());
-                            IGC_ASSERT(vFunc);
-                            bool enabled = true;
-                            vFunc->AddKernelAttribute("LTO_InvokeOptTarget", 1, &enabled);
-                        }
-                    }
+                    markInvokeSimdTargets(vAsmTextBuilder);
                 }
             }
 
             if (result != 0) {
-                std::string output;
-                raw_string_ostream S(output);
-                S << "parsing vISA inline assembly failed:\n"
-                  << vAsmTextBuilder->GetCriticalMsg();
-                S.flush();
-                context->EmitError(output.c_str(), nullptr);
+                reportInlineAsmParseError(vAsmTextBuilder);
                 vISAAsmParseError = true;
             }
         }
@@ -6131,11 +6137,70 @@ namespace IGC
         return pMainKernel;
     }
 
+    void CEncoder::markInvokeSimdTargets(VISABuilder* builder)
+    {
+        // Mark invoke_simd targets with LTO_InvokeOptTarget attribute.
+        IGC_ASSERT(m_program && m_program->GetContext() &&
+                   m_program->GetContext()->getModule());
+        for (auto &F : m_program->GetContext()->getModule()->getFunctionList()) {
+            if (F.hasFnAttribute("invoke_simd_target")) {
+                auto vFunc = builder->GetVISAKernel(F.getName().data());
+                IGC_ASSERT(vFunc);
+                bool enabled = true;
+                vFunc->AddKernelAttribute("LTO_InvokeOptTarget", 1, &enabled);
+            }
+        }
+    }
+
+    void CEncoder::reportInlineAsmParseError(VISABuilder* builder)
+    {
+        std::string output;
+        raw_string_ostream S(output);
+        S << "parsing vISA inline assembly failed:\n"
+          << builder->GetCriticalMsg();
+        S.flush();
+        m_program->GetContext()->EmitError(output.c_str(), nullptr);
+    }
+
+    void CEncoder::ParseInlineAsm(const std::string& asmText)
+    {
+        IGC_ASSERT(m_mergeInlineAsm);
+        // Report the first error only, later blocks may refer to its variables
+        if (!m_inlineAsmParseError &&
+            vbuilder->ParseVISAInlineAsm(vKernel, asmText) != 0)
+        {
+            reportInlineAsmParseError(vbuilder);
+            m_inlineAsmParseError = true;
+        }
+    }
+
+    bool CEncoder::mergeVISAAsmToLink(const std::vector<const char*>* additionalVISAAsmToLink)
+    {
+        if (m_inlineAsmParseError)
+        {
+            return false;
+        }
+        if (!additionalVISAAsmToLink)
+        {
+            return true;
+        }
+
+        for (auto visaAsm : *additionalVISAAsmToLink)
+        {
+            if (vbuilder->ParseVISAText(visaAsm, "") != 0)
+            {
+                reportInlineAsmParseError(vbuilder);
+                return false;
+            }
+        }
+        markInvokeSimdTargets(vbuilder);
+        return true;
+    }
+
     void CEncoder::Compile(bool hasSymbolTable, GenXFunctionGroupAnalysis*& pFGA)
     {
         IGC_ASSERT(nullptr != m_program);
         CodeGenContext* const context = m_program->GetContext();
-        SProgramOutput* const pOutput = m_program->ProgramOutput();
         const std::vector<const char*>* additionalVISAAsmToLink = nullptr;
         bool emitVisaOnly = false;
 
@@ -6172,10 +6237,9 @@ namespace IGC
               shaderOverrideVISAFirstPass(visaOverrideFiles, kernelName);
         }
 
-        vISA::FINALIZER_INFO* jitInfo = nullptr;
-
         // Compile generated VISA text string for inlineAsm
-        if (m_hasInlineAsm || visaAsmOverride || additionalVISAAsmToLink)
+        if (visaAsmOverride ||
+            ((m_hasInlineAsm || additionalVISAAsmToLink) && !m_mergeInlineAsm))
         {
             pMainKernel = shaderOverrideVISASecondPassOrInlineAsm(
               visaAsmOverride, hasSymbolTable, emitVisaOnly,
@@ -6183,15 +6247,70 @@ namespace IGC
             // return immediately if there is error during parsing visaasm
             if (pMainKernel == nullptr)
                 return;
-            pMainKernel->GetJitInfo(jitInfo);
         }
         //Compile to generate the V-ISA binary
         else
         {
+            if (m_mergeInlineAsm && !mergeVISAAsmToLink(additionalVISAAsmToLink))
+            {
+                COMPILER_TIME_END(m_program->GetContext(), TIME_CG_vISACompile);
+                return;
+            }
+
             pMainKernel = vMainKernel;
+            vISA::FINALIZER_INFO* jitInfo = nullptr;
             pMainKernel->GetJitInfo(jitInfo);
 
             jitInfo->stats.scratchSpaceSizeLimit = m_program->ProgramOutput()->m_scratchSpaceSizeLimit;
+
+            llvm::ThreadPool* pool = context->type == ShaderType::OPENCL_SHADER ?
+                static_cast<OpenCLProgramContext*>(context)->m_SIMDVariantCompilePool : nullptr;
+            if (pool && !visaAsmOverride)
+            {
+                // Run the backend of this SIMD variant while the next variant is
+                // emitted. Apart from its own builder, Compile only uses vISA
+                // timers, which vISA keeps per thread; the worker hands their
+                // values over with the result. Results are collected in
+                // FinishCompile, in the same order as the serial flow.
+                std::string asmName = m_enableVISAdump ? GetDumpFileName("isaasm") : "";
+                m_pendingHasSymbolTable = hasSymbolTable;
+                m_pendingFGA = pFGA;
+                m_pendingAsmName = asmName;
+                m_pendingEmitVisaOnly = emitVisaOnly;
+                m_compileSkipped = false;
+
+                // This variant is not needed if a wider one compiles. That one was
+                // queued earlier, so waiting for it cannot block the pool.
+                CEncoder* pWider = static_cast<COpenCLKernel*>(m_program)->GetPendingWiderSIMDVariant(*m_program->entry);
+                std::shared_future<void> wider = pWider ? pWider->m_pendingCompile : std::shared_future<void>();
+                m_pendingCompile = pool->async([this, asmName, emitVisaOnly, pWider, wider]() {
+                    if (pWider)
+                    {
+                        wider.wait();
+                        if (pWider->m_compileSkipped || pWider->m_vIsaCompileStatus == VISA_SUCCESS)
+                        {
+                            m_compileSkipped = true;
+                            return;
+                        }
+                    }
+#if GET_TIME_STATS
+                    // Pool threads keep their timers across compiles
+                    VISATimerValues before = TimeStats::readVISATimers();
+#endif
+                    m_vIsaCompileStatus = vbuilder->Compile(asmName.c_str(), emitVisaOnly);
+#if GET_TIME_STATS
+                    m_pendingVISATimers = TimeStats::readVISATimers();
+                    for (size_t i = 0; i < before.ticks.size(); ++i)
+                    {
+                        m_pendingVISATimers.ticks[i] -= before.ticks[i];
+                        m_pendingVISATimers.hits[i] -= before.hits[i];
+                    }
+#endif
+                });
+                COMPILER_TIME_END(m_program->GetContext(), TIME_CG_vISACompile);
+                return;
+            }
+
             m_vIsaCompileStatus = vbuilder->Compile(
                 m_enableVISAdump ? GetDumpFileName("isaasm").c_str() : "",
                 emitVisaOnly);
@@ -6199,12 +6318,49 @@ namespace IGC
 
         COMPILER_TIME_END(m_program->GetContext(), TIME_CG_vISACompile);
 
+        ProcessCompileResult(pMainKernel, hasSymbolTable, pFGA, kernelName, emitVisaOnly, additionalVISAAsmToLink);
+    }
+
+    void CEncoder::FinishCompile()
+    {
+        IGC_ASSERT(IsCompilePending());
+        m_pendingCompile.wait();
+        m_pendingCompile = std::shared_future<void>();
+
+        if (m_compileSkipped)
+        {
+            // The wider variant did not supersede this one after all. The flag
+            // is left set since narrower variants may still be reading it.
+            m_vIsaCompileStatus = vbuilder->Compile(m_pendingAsmName.c_str(), m_pendingEmitVisaOnly);
+        }
+
+        ProcessCompileResult(vMainKernel, m_pendingHasSymbolTable, m_pendingFGA, "", false, nullptr);
+        m_pendingFGA = nullptr;
+    }
+
+    void CEncoder::ProcessCompileResult(VISAKernel* pMainKernel, bool hasSymbolTable,
+        GenXFunctionGroupAnalysis*& pFGA, const std::string& kernelName, bool emitVisaOnly,
+        const std::vector<const char*>* additionalVISAAsmToLink)
+    {
+        CodeGenContext* const context = m_program->GetContext();
+        SProgramOutput* const pOutput = m_program->ProgramOutput();
+        vISA::FINALIZER_INFO* jitInfo = nullptr;
+        pMainKernel->GetJitInfo(jitInfo);
+
 #if GET_TIME_STATS
         // handle the vISA time counters differently here
         if (context->m_compilerTimeStats)
         {
-            context->m_compilerTimeStats->recordVISATimers();
+            if (!m_pendingVISATimers.ticks.empty())
+            {
+                context->m_compilerTimeStats->recordVISATimers(m_pendingVISATimers);
+            }
+            else
+            {
+                context->m_compilerTimeStats->recordVISATimers();
+            }
         }
+        m_pendingVISATimers = VISATimerValues();
 #endif
 
         KERNEL_INFO* vISAstats;
@@ -6737,6 +6893,12 @@ namespace IGC
 
     void CEncoder::DestroyVISABuilder()
     {
+        // A compile started on the SIMD variant pool still uses the builder
+        if (m_pendingCompile.valid())
+        {
+            m_pendingCompile.wait();
+            m_pendingCompile = std::shared_future<void>();
+        }
         if (vAsmTextBuilder != nullptr)
         {
             V(::DestroyVISABuilder(vAsmTextBuilder));
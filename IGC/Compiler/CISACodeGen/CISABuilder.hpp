@@ -15,6 +15,9 @@ SPDX-License-Identifier: MIT
 #include "Compiler/CISACodeGen/GenCodeGenModule.h"
 #include "visa_wa.h"
 #include "inc/common/sku_wa.h"
+#include "common/Stats.hpp"
+
+#include <future>
 
 namespace IGC
 {
@@ -136,6 +139,10 @@ namespace IGC
         void MarkAsOutput(CVariable* var);
         void MarkAsPayloadLiveOut(CVariable* var);
         void Compile(bool hasSymbolTable, GenXFunctionGroupAnalysis*& pFGA);
+        /// \brief Waits for a vISA compile that Compile() handed to the SIMD
+        /// variant worker pool and collects its results.
+        void FinishCompile();
+        bool IsCompilePending() const { return m_pendingCompile.valid(); }
         std::string GetShaderName();
 
         CEncoder();
@@ -510,6 +517,11 @@ namespace IGC
 
         std::string GetUniqueInlineAsmLabel();
 
+        bool IsInlineAsmMerged() const { return m_mergeInlineAsm; }
+        /// ParseInlineAsm - parses the vISA text of an inline asm block into the
+        /// current kernel. Only used if IsInlineAsmMerged().
+        void ParseInlineAsm(const std::string& asmText);
+
         bool IsVisaCompiledSuccessfully() const { return m_vIsaCompileStatus == VISA_SUCCESS; }
         bool IsVisaCompileStatusFailure() const { return m_vIsaCompileStatus == VISA_FAILURE; }
 
@@ -711,6 +723,18 @@ namespace IGC
             const std::vector<std::string> &visaOverrideFiles,
             const std::string kernelName);
 
+        /// mergeVISAAsmToLink - parses vISA asm to link into the builder of
+        /// the in-memory kernels when inline asm is merged. Return false on a
+        /// parse error, either there or in an earlier inline asm block.
+        bool mergeVISAAsmToLink(const std::vector<const char*>* additionalVISAAsmToLink);
+        void markInvokeSimdTargets(VISABuilder* builder);
+        void reportInlineAsmParseError(VISABuilder* builder);
+
+        // Collects binary, statistics and tables from a finished vISA compile
+        void ProcessCompileResult(VISAKernel* pMainKernel, bool hasSymbolTable,
+            GenXFunctionGroupAnalysis*& pFGA, const std::string& kernelName, bool emitVisaOnly,
+            const std::vector<const char*>* additionalVISAAsmToLink);
+
         // setup m_retryManager according to jitinfo and other factors
         void SetKernelRetryState(CodeGenContext* context, vISA::FINALIZER_INFO* jitInfo, GenXFunctionGroupAnalysis*& pFGA);
 
@@ -784,6 +808,10 @@ namespace IGC
 
         bool m_enableVISAdump = false;
         bool m_hasInlineAsm = false;
+        // Inline asm and vISA asm to link are parsed into the in-memory kernel
+        // instead of a text builder
+        bool m_mergeInlineAsm = false;
+        bool m_inlineAsmParseError = false;
 
         std::vector<VISA_LabelOpnd*> labelMap;
         std::vector<CName> labelNameMap; // parallel to labelMap
@@ -812,6 +840,20 @@ namespace IGC
         CShader* m_program;
         int m_vIsaCompileStatus = VISA_FAILURE;
 
+        // vISA compile running on the SIMD variant worker pool, see Compile()
+        std::shared_future<void> m_pendingCompile;
+        bool m_pendingHasSymbolTable = false;
+        GenXFunctionGroupAnalysis* m_pendingFGA = nullptr;
+        std::string m_pendingAsmName;
+        bool m_pendingEmitVisaOnly = false;
+        // Set by the worker when a wider SIMD variant compiled and this one was
+        // not handed to vISA
+        bool m_compileSkipped = false;
+#if GET_TIME_STATS
+        // vISA timers of the pending compile, measured on its worker thread
+        VISATimerValues m_pendingVISATimers;
+#endif
+
         // Keep a map between a function and its per-function attributes needed for function pointer support
         struct FuncAttrib
         {
@@ -644,6 +644,9 @@ bool EmitPass::runOnFunction(llvm::Function& F)
         return false;
     }
 
+    IGC::TraceEventScope traceScope("EmitVISAPass " + F.getName().str() +
+        " SIMD" + std::to_string(numLanes(m_SimdMode)), "IGC");
+
     bool isDummyKernel = IGC::isIntelSymbolTableVoidProgram(&F);
     bool isFuncGroupHead = !m_FGA || m_FGA->isGroupHead(&F);
     bool hasStackCall = m_FGA && m_FGA->getGroup(&F) && m_FGA->getGroup(&F)->hasStackCall();
@@ -1301,7 +1304,12 @@ bool EmitPass::runOnFunction(llvm::Function& F)
             m_pCtx->m_prevShader = nullptr;
             // Postpone destroying VISA builder to
             // after emitting debug info and passing context for code patching
-            m_encoder->DestroyVISABuilder();
+            // A compile still running on the SIMD variant pool releases the
+            // builder once its results are collected.
+            if (!m_encoder->IsCompilePending())
+            {
+                m_encoder->DestroyVISABuilder();
+            }
         }
         if (m_encoder->IsCodePatchCandidate() && m_encoder->HasPrevKernel())
         {
@@ -1309,18 +1317,9 @@ bool EmitPass::runOnFunction(llvm::Function& F)
         }
     }
 
-    if ((m_currShader->GetShaderType() == ShaderType::COMPUTE_SHADER ||
-        m_currShader->GetShaderType() == ShaderType::OPENCL_SHADER) &&
-        m_currShader->m_Platform->supportDisableMidThreadPreemptionSwitch() &&
-        IGC_IS_FLAG_ENABLED(EnableDisableMidThreadPreemptionOpt) &&
-        (m_currShader->GetContext()->m_instrTypes.numLoopInsts == 0) &&
-        (m_currShader->ProgramOutput()->m_InstructionCount < IGC_GET_FLAG_VALUE(MidThreadPreemptionDisableThreshold)))
+    if (!m_encoder->IsCompilePending())
     {
-
-        {
-            COpenCLKernel* kernel = static_cast<COpenCLKernel*>(m_currShader);
-            kernel->SetDisableMidthreadPreemption();
-        }
+        UpdateMidThreadPreemption(m_currShader);
     }
 
     if (IGC_IS_FLAG_ENABLED(ForceBestSIMD))
@@ -1345,6 +1344,23 @@ bool EmitPass::runOnFunction(llvm::Function& F)
     return false;
 }
 
+void EmitPass::UpdateMidThreadPreemption(CShader* pShader)
+{
+    if ((pShader->GetShaderType() == ShaderType::COMPUTE_SHADER ||
+        pShader->GetShaderType() == ShaderType::OPENCL_SHADER) &&
+        pShader->m_Platform->supportDisableMidThreadPreemptionSwitch() &&
+        IGC_IS_FLAG_ENABLED(EnableDisableMidThreadPreemptionOpt) &&
+        (pShader->GetContext()->m_instrTypes.numLoopInsts == 0) &&
+        (pShader->ProgramOutput()->m_InstructionCount < IGC_GET_FLAG_VALUE(MidThreadPreemptionDisableThreshold)))
+    {
+
+        {
+            COpenCLKernel* kernel = static_cast<COpenCLKernel*>(pShader);
+            kernel->SetDisableMidthreadPreemption();
+        }
+    }
+}
+
 // Emit code in slice starting from (reverse) iterator I. Return the iterator to
 // the next pattern to emit.
 SBasicBlock::reverse_iterator
@@ -8753,7 +8769,6 @@ bool EmitPass::validateInlineAsmConstraints(llvm::CallInst* inst, SmallVector<St
 // Example: "mul (M1, 16) $0(0, 0)<1> $1(0, 0)<1;1,0> $2(0, 0)<1;1,0>", "=r,r,r"(float %6, float %7)
 void EmitPass::EmitInlineAsm(llvm::CallInst* inst)
 {
-    std::stringstream& str = m_encoder->GetVISABuilder()->GetAsmTextStream();
     InlineAsm* IA = cast<InlineAsm>(IGCLLVM::getCalledValue(inst));
     string asmStr = IA->getAsmString();
     smallvector<CVariable*, 8> opnds;
@@ -8882,7 +8897,6 @@ void EmitPass::EmitInlineAsm(llvm::CallInst* inst)
         }
     }
 
-    str << endl << "/// Inlined ASM" << endl;
     // Look for variables to replace with the VISA variable
     size_t startPos = 0;
     while (startPos < asmStr.size())
@@ -8914,6 +8928,14 @@ void EmitPass::EmitInlineAsm(llvm::CallInst* inst)
         startPos = varPos + varName.size();
     }
 
+    if (m_encoder->IsInlineAsmMerged())
+    {
+        m_encoder->ParseInlineAsm(asmStr);
+        return;
+    }
+
+    std::stringstream& str = m_encoder->GetVISABuilder()->GetAsmTextStream();
+    str << endl << "/// Inlined ASM" << endl;
     str << asmStr;
     if (asmStr.back() != '\n') str << endl;
     str << "/// End Inlined ASM" << endl << endl;
@@ -85,6 +85,9 @@ public:
 
     void CreateKernelShaderMap(CodeGenContext* ctx, IGC::IGCMD::MetaDataUtils* pMdUtils, llvm::Function& F);
 
+    // Needs the final instruction count, so it runs once the vISA compile of the shader is done
+    static void UpdateMidThreadPreemption(CShader* pShader);
+
     void Frc(const SSource& source, const DstModifier& modifier);
     void Floor(const SSource& source, const DstModifier& modifier);
     void Mad(const SSource sources[3], const DstModifier& modifier);
@@ -0,0 +1,112 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "Compiler/CISACodeGen/FinalizeSIMDVariants.hpp"
+#include "Compiler/CISACodeGen/EmitVISAPass.hpp"
+#include "Compiler/CISACodeGen/GenCodeGenModule.h"
+#include "Compiler/CISACodeGen/OpenCLKernelCodeGen.hpp"
+#include "Compiler/IGCPassSupport.h"
+
+#include "common/LLVMWarningsPush.hpp"
+#include <llvm/ADT/SmallVector.h>
+#include "common/LLVMWarningsPop.hpp"
+
+using namespace llvm;
+using namespace IGC;
+
+namespace {
+    class FinalizeSIMDVariants : public FunctionPass
+    {
+    public:
+        static char ID;
+
+        FinalizeSIMDVariants()
+            : FunctionPass(ID), m_shaders(nullptr)
+        {
+            initializeFinalizeSIMDVariantsPass(*PassRegistry::getPassRegistry());
+        }
+
+        FinalizeSIMDVariants(CShaderProgram::KernelShaderMap& shaders, ArrayRef<SIMDMode> order)
+            : FunctionPass(ID), m_shaders(&shaders), m_order(order.begin(), order.end())
+        {
+            initializeFinalizeSIMDVariantsPass(*PassRegistry::getPassRegistry());
+        }
+
+        StringRef getPassName() const override { return "FinalizeSIMDVariants"; }
+
+        void getAnalysisUsage(AnalysisUsage& AU) const override
+        {
+            AU.setPreservesAll();
+        }
+
+        bool runOnFunction(Function& F) override;
+
+    private:
+        CShaderProgram::KernelShaderMap* m_shaders;
+        SmallVector<SIMDMode, 3> m_order;
+    };
+} // End anonymous namespace
+
+FunctionPass* IGC::createFinalizeSIMDVariantsPass(
+    CShaderProgram::KernelShaderMap& shaders, ArrayRef<SIMDMode> order)
+{
+    return new FinalizeSIMDVariants(shaders, order);
+}
+
+char FinalizeSIMDVariants::ID = 0;
+
+#define PASS_FLAG     "igc-finalize-simd-variants"
+#define PASS_DESC     "Collect results of SIMD variants compiled in parallel"
+#define PASS_CFG_ONLY false
+#define PASS_ANALYSIS false
+namespace IGC {
+    IGC_INITIALIZE_PASS_BEGIN(FinalizeSIMDVariants, PASS_FLAG, PASS_DESC, PASS_CFG_ONLY, PASS_ANALYSIS)
+    IGC_INITIALIZE_PASS_END(FinalizeSIMDVariants, PASS_FLAG, PASS_DESC, PASS_CFG_ONLY, PASS_ANALYSIS)
+}
+
+bool FinalizeSIMDVariants::runOnFunction(Function& F)
+{
+    if (!m_shaders)
+        return false;
+
+    // vISA compiles are started when the last function of a group is emitted
+    Function* Head = &F;
+    if (auto* FGA = getAnalysisIfAvailable<GenXFunctionGroupAnalysis>())
+    {
+        if (!FGA->isGroupTail(&F))
+            return false;
+        if (FGA->getGroup(&F))
+            Head = FGA->getGroupHead(&F);
+    }
+
+    auto It = m_shaders->find(Head);
+    if (It == m_shaders->end())
+        return false;
+
+    CShaderProgram* pKernel = It->second;
+    for (SIMDMode mode : m_order)
+    {
+        auto* pShader = static_cast<COpenCLKernel*>(pKernel->GetShader(mode));
+        if (!pShader || !pShader->GetEncoder().IsCompilePending())
+            continue;
+
+        // Same check the serial flow does in checkSIMDCompileConds before
+        // emitting this variant, with all preceding variants already collected.
+        if (pShader->GetContext()->platform.getMinDispatchMode() != SIMDMode::SIMD16 &&
+            pShader->IsSupersededBySIMDVariant(*Head))
+        {
+            pShader->DiscardSIMDVariant(*Head);
+            continue;
+        }
+
+        pShader->GetEncoder().FinishCompile();
+        pShader->GetEncoder().DestroyVISABuilder();
+        EmitPass::UpdateMidThreadPreemption(pShader);
+    }
+    return false;
+}
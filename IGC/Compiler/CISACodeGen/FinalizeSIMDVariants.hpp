@@ -0,0 +1,26 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "common/LLVMWarningsPush.hpp"
+#include <llvm/Pass.h>
+#include <llvm/ADT/ArrayRef.h>
+#include "common/LLVMWarningsPop.hpp"
+#include "Compiler/CISACodeGen/CShaderProgram.hpp"
+
+namespace IGC
+{
+    // Collects the results of SIMD variants whose vISA compiles were started on
+    // OpenCLProgramContext::m_SIMDVariantCompilePool. Variants are visited in the
+    // order their EmitPasses were added, and a variant the serial flow would not
+    // have compiled is dropped, so the selected binary is unchanged.
+    llvm::FunctionPass* createFinalizeSIMDVariantsPass(
+        CShaderProgram::KernelShaderMap& shaders, llvm::ArrayRef<SIMDMode> order);
+    void initializeFinalizeSIMDVariantsPass(llvm::PassRegistry&);
+} // namespace IGC
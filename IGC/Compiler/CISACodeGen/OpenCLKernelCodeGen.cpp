@@ -14,6 +14,7 @@ SPDX-License-Identifier: MIT
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvmWrapper/Option/OptTable.h"
+#include "llvmWrapper/Support/ThreadPool.h"
 #include "common/LLVMWarningsPop.hpp"
 #include "AdaptorCommon/ImplicitArgs.hpp"
 #include "Compiler/CISACodeGen/ShaderCodeGen.hpp"
@@ -25,6 +26,7 @@ SPDX-License-Identifier: MIT
 #include "Compiler/Optimizer/OpenCLPasses/LocalBuffers/InlineLocalsResolution.hpp"
 #include "Compiler/Optimizer/OpenCLPasses/KernelArgs.hpp"
 #include "Compiler/CISACodeGen/EmitVISAPass.hpp"
+#include "Compiler/CISACodeGen/FinalizeSIMDVariants.hpp"
 #include "Compiler/Optimizer/OCLBIUtils.h"
 #include "AdaptorOCL/OCL/KernelAnnotations.hpp"
 #include "common/allocator.h"
@@ -341,7 +343,7 @@ namespace IGC
 
         if (internalOptions.hasArg(OPT_disable_recompilation_common))
         {
-            IGC_SET_FLAG_VALUE(DisableRecompilation, true);
+            DisableRecompilation = true;
         }
 
         if (internalOptions.hasArg(OPT_force_emu_int32divrem_common))
@@ -454,6 +456,14 @@ namespace IGC
             CompileOneKernelAtTime = true;
         }
 
+        if (const opt::Arg* arg = internalOptions.getLastArg(OPT_entry_points_common))
+        {
+            SmallVector<StringRef, 8> names;
+            StringRef(arg->getValue()).split(names, ',', -1, false);
+            for (StringRef name : names)
+                EntryPoints.push_back(name.trim().str());
+        }
+
         if (internalOptions.hasArg(OPT_skip_reloc_add_common))
         {
             AllowRelocAdd = false;
@@ -3673,6 +3683,24 @@ namespace IGC
         return result;
     }
 
+    // SIMD variants are emitted up front and compiled in parallel only when the
+    // choice between them depends on nothing but their own vISA compile results.
+    // Stage 1 of staged compilation decides whether to emit SIMD8 from the
+    // compiled SIMD16 (best perf), or compiles wider SIMDs from the SIMD8 pass
+    // (fast compile), so it is left serial.
+    static bool canCompileSIMDVariantsInParallel(OpenCLProgramContext* ctx)
+    {
+        return IGC_IS_FLAG_ENABLED(EnableParallelSIMDVariantCompile) &&
+            !IsStagingContextStage1(ctx) &&
+            !ctx->m_DriverInfo.sendMultipleSIMDModes() &&
+            !ctx->m_InternalOptions.EmitVisaOnly &&
+            !ctx->m_instrTypes.hasDebugInfo &&
+            ctx->m_VISAAsmToLink.empty() &&
+            IGC_IS_FLAG_DISABLED(ShaderOverride) &&
+            IGC_IS_FLAG_DISABLED(DumpVISAASMToConsole) &&
+            IGC_IS_FLAG_DISABLED(ForceBestSIMD);
+    }
+
     static void CodeGen(OpenCLProgramContext* ctx, CShaderProgram::KernelShaderMap& shaders)
     {
         COMPILER_TIME_START(ctx, TIME_CodeGen);
@@ -3723,6 +3751,7 @@ namespace IGC
             return;
         }
 
+        std::unique_ptr<llvm::ThreadPool> SIMDVariantCompilePool;
         if (ctx->m_DriverInfo.sendMultipleSIMDModes())
         {
             unsigned int leastSIMD = 8;
@@ -3758,11 +3787,23 @@ namespace IGC
         }
         else
         {
+            if (canCompileSIMDVariantsInParallel(ctx))
+            {
+                SIMDVariantCompilePool = IGCLLVM::createThreadPool(
+                    IGC_GET_FLAG_VALUE(ParallelSIMDVariantCompileThreads));
+                ctx->m_SIMDVariantCompilePool = SIMDVariantCompilePool.get();
+            }
+
             if (ctx->platform.getMinDispatchMode() == SIMDMode::SIMD16)
             {
                 AddCodeGenPasses(*ctx, shaders, Passes, SIMDMode::SIMD32, false);
                 AddCodeGenPasses(*ctx, shaders, Passes, SIMDMode::SIMD16, false);
 
+                if (SIMDVariantCompilePool)
+                {
+                    Passes.add(createFinalizeSIMDVariantsPass(shaders, { SIMDMode::SIMD32, SIMDMode::SIMD16 }));
+                }
+
                 ctx->SetSIMDInfo(SIMD_SKIP_HW, SIMDMode::SIMD8, ShaderDispatchMode::NOT_APPLICABLE);
             }
             else
@@ -3771,6 +3812,11 @@ namespace IGC
                 AddCodeGenPasses(*ctx, shaders, Passes, SIMDMode::SIMD32, (ctx->getModuleMetaData()->csInfo.forcedSIMDSize != 32));
                 AddCodeGenPasses(*ctx, shaders, Passes, SIMDMode::SIMD16, (ctx->getModuleMetaData()->csInfo.forcedSIMDSize != 16));
                 AddCodeGenPasses(*ctx, shaders, Passes, SIMDMode::SIMD8, false);
+
+                if (SIMDVariantCompilePool)
+                {
+                    Passes.add(createFinalizeSIMDVariantsPass(shaders, { SIMDMode::SIMD32, SIMDMode::SIMD16, SIMDMode::SIMD8 }));
+                }
             }
         }
 
@@ -3778,6 +3824,7 @@ namespace IGC
         COMPILER_TIME_END(ctx, TIME_CG_Add_Passes);
 
         Passes.run(*(ctx->getModule()));
+        ctx->m_SIMDVariantCompilePool = nullptr;
         COMPILER_TIME_END(ctx, TIME_CodeGen);
         DumpLLVMIR(ctx, "codegen");
     }
@@ -4005,6 +4052,7 @@ namespace IGC
         }
 
         SIMDStatus simdStatus = SIMDStatus::SIMD_FUNC_FAIL;
+        const uint64_t SIMDInfo = m_Context->GetSIMDInfo();
         if (m_Context->platform.getMinDispatchMode() == SIMDMode::SIMD16)
         {
             simdStatus = checkSIMDCompileCondsPVC(simdMode, EP, F, hasSyncRTCalls);
@@ -4013,6 +4061,7 @@ namespace IGC
         {
             simdStatus = checkSIMDCompileConds(simdMode, EP, F, hasSyncRTCalls);
         }
+        m_SIMDInfoFromCompileConds = m_Context->GetSIMDInfo() & ~SIMDInfo;
 
         // Func and Perf checks pass, compile this SIMD
         if (simdStatus == SIMDStatus::SIMD_PASS)
@@ -4178,26 +4227,75 @@ namespace IGC
         return m_largeGRFRequested;
     }
 
-    SIMDStatus COpenCLKernel::checkSIMDCompileConds(SIMDMode simdMode, EmitPass& EP, llvm::Function& F, bool hasSyncRTCalls)
+    bool COpenCLKernel::CanBeSupersededBySIMDVariant(llvm::Function& F)
     {
-        CShader* simd8Program = m_parent->GetShader(SIMDMode::SIMD8);
-        CShader* simd16Program = m_parent->GetShader(SIMDMode::SIMD16);
-        CShader* simd32Program = m_parent->GetShader(SIMDMode::SIMD32);
-
         CodeGenContext* pCtx = GetContext();
 
         bool compileFunctionVariants = pCtx->m_enableSimdVariantCompilation &&
             (m_FGA && IGC::isIntelSymbolTableVoidProgram(m_FGA->getGroupHead(&F)));
+        bool canCompileMultipleSIMD = pCtx->m_DriverInfo.sendMultipleSIMDModes() || compileFunctionVariants;
+        return !(canCompileMultipleSIMD && (pCtx->getModuleMetaData()->csInfo.forcedSIMDSize == 0));
+    }
+
+    bool COpenCLKernel::IsSupersededBySIMDVariant(llvm::Function& F)
+    {
+        CShader* simd8Program = m_parent->GetShader(SIMDMode::SIMD8);
+        CShader* simd16Program = m_parent->GetShader(SIMDMode::SIMD16);
+        CShader* simd32Program = m_parent->GetShader(SIMDMode::SIMD32);
 
         // Here we see if we have compiled a size for this shader already
         if ((simd8Program && simd8Program->ProgramOutput()->m_programSize > 0) ||
             (simd16Program && simd16Program->ProgramOutput()->m_programSize > 0) ||
             (simd32Program && simd32Program->ProgramOutput()->m_programSize > 0))
         {
-            bool canCompileMultipleSIMD = pCtx->m_DriverInfo.sendMultipleSIMDModes() || compileFunctionVariants;
-            if (!(canCompileMultipleSIMD && (pCtx->getModuleMetaData()->csInfo.forcedSIMDSize == 0)))
-                return SIMDStatus::SIMD_FUNC_FAIL;
+            return CanBeSupersededBySIMDVariant(F);
         }
+        return false;
+    }
+
+    CEncoder* COpenCLKernel::GetPendingWiderSIMDVariant(llvm::Function& F)
+    {
+        // FinalizeSIMDVariants never drops a variant on these platforms
+        if (GetContext()->platform.getMinDispatchMode() == SIMDMode::SIMD16 ||
+            !CanBeSupersededBySIMDVariant(F))
+        {
+            return nullptr;
+        }
+
+        for (SIMDMode mode : { SIMDMode::SIMD16, SIMDMode::SIMD32 })
+        {
+            if (numLanes(mode) <= numLanes(m_dispatchSize))
+                continue;
+            CShader* pShader = m_parent->GetShader(mode);
+            if (pShader && pShader->GetEncoder().IsCompilePending())
+                return &pShader->GetEncoder();
+        }
+        return nullptr;
+    }
+
+    void COpenCLKernel::DiscardSIMDVariant(llvm::Function& F)
+    {
+        // The serial flow stops in checkSIMDCompileConds before any of these
+        // were recorded, so drop them to keep the driver-visible state identical.
+        GetContext()->ClearSIMDInfoBits(m_SIMDInfoFromCompileConds);
+        m_SIMDInfoFromCompileConds = 0;
+        if (m_FGA)
+        {
+            if (auto* FG = m_FGA->getGroup(&F))
+                FG->setSimdModeInvalid(m_dispatchSize);
+        }
+        GetEncoder().DestroyVISABuilder();
+    }
+
+    SIMDStatus COpenCLKernel::checkSIMDCompileConds(SIMDMode simdMode, EmitPass& EP, llvm::Function& F, bool hasSyncRTCalls)
+    {
+        CodeGenContext* pCtx = GetContext();
+
+        if (IsSupersededBySIMDVariant(F))
+            return SIMDStatus::SIMD_FUNC_FAIL;
+
+        bool compileFunctionVariants = pCtx->m_enableSimdVariantCompilation &&
+            (m_FGA && IGC::isIntelSymbolTableVoidProgram(m_FGA->getGroupHead(&F)));
 
         // Next we check if there is a required sub group size specified
         MetaDataUtils* pMdUtils = EP.getAnalysis<MetaDataUtilsWrapper>().getMetaDataUtils();
@@ -4395,6 +4493,22 @@ namespace IGC
                     return SIMDStatus::SIMD_FUNC_FAIL;
                 }
 
+                // Under a compile-time budget, leave out SIMD32 at the same share of
+                // the budget where vISA stops pre-RA scheduling, as SIMD32 takes the
+                // longest in vISA and is compiled again as SIMD16 on spills. The
+                // LLVM instruction count stands in for the vISA kernel size.
+                const int64_t budgetMs = IGC_GET_FLAG_VALUE(CompileTimeBudgetMs);
+                if (budgetMs != 0)
+                {
+                    const double sizeShare = (double)F.getInstructionCount() /
+                        ((double)CompileTimeBudget::SizePerMs * budgetMs);
+                    if (sizeShare >= CompileTimeBudget::NoScheduleShare)
+                    {
+                        pCtx->SetSIMDInfo(SIMD_SKIP_PERF, simdMode, ShaderDispatchMode::NOT_APPLICABLE);
+                        return SIMDStatus::SIMD_PERF_FAIL;
+                    }
+                }
+
                 // bail out of SIMD32 if it's not profitable.
                 Simd32ProfitabilityAnalysis& PA = EP.getAnalysis<Simd32ProfitabilityAnalysis>();
                 if (!PA.isSimd32Profitable())
@@ -9,6 +9,11 @@ SPDX-License-Identifier: MIT
 #pragma once
 #include "Compiler/CISACodeGen/ComputeShaderBase.hpp"
 
+namespace llvm
+{
+    class ThreadPool;
+}
+
 namespace IGC
 {
     class KernelArg;
@@ -66,6 +71,8 @@ namespace IGC
             bool DisableNoMaskWA                            = false;
             bool IgnoreBFRounding                           = false;   // If true, ignore BFloat rounding when folding bf operations
             bool CompileOneKernelAtTime                     = false;
+            // Kernels to translate from SPIR-V, all of them if empty.
+            std::vector<std::string> EntryPoints;
 
             // Generic address related
             bool ForceGlobalMemoryAllocation                = false;
@@ -82,6 +89,10 @@ namespace IGC
             bool IntelExpGRFSize                            = false;
             uint32_t expGRFSize                             = 0;
 
+            // Kept per context rather than in the DisableRecompilation regkey,
+            // kernels compiled in parallel parse their options on worker threads
+            bool DisableRecompilation                       = false;
+
             // IntelForceInt32DivRemEmu is used only if fp64 is supported natively.
             // IntelForceInt32DivRemEmu wins if both are set and can be applied.
             bool IntelForceInt32DivRemEmu                   = false;
@@ -199,6 +210,9 @@ namespace IGC
         std::vector<const char*> m_VISAAsmToLink;
         // Functions that are forced to be direct calls.
         std::unordered_set<std::string> m_DirectCallFunctions;
+        // Worker pool running the vISA compiles of SIMD variants when
+        // EnableParallelSIMDVariantCompile is on. Only set during CodeGen.
+        llvm::ThreadPool* m_SIMDVariantCompilePool = nullptr;
 
         OpenCLProgramContext(
             const COCLBTILayout& btiLayout,
@@ -306,6 +320,19 @@ namespace IGC
         SIMDStatus  checkSIMDCompileConds(SIMDMode simdMode, EmitPass& EP, llvm::Function& F, bool hasSyncRTCalls);
         SIMDStatus  checkSIMDCompileCondsPVC(SIMDMode simdMode, EmitPass& EP, llvm::Function& F, bool hasSyncRTCalls);
 
+        // Returns true if another SIMD variant of this kernel already has a binary
+        // and the serial flow would not compile this one.
+        bool IsSupersededBySIMDVariant(llvm::Function& F);
+        // Returns false if the serial flow compiles this SIMD variant whatever
+        // the results of the other variants are.
+        bool CanBeSupersededBySIMDVariant(llvm::Function& F);
+        // Returns the encoder of the nearest wider SIMD variant whose vISA compile
+        // is still running on the worker pool, if its success supersedes this one.
+        CEncoder* GetPendingWiderSIMDVariant(llvm::Function& F);
+        // Drops the state recorded for a SIMD variant whose vISA compile was started
+        // in parallel but that turned out to be superseded by a wider SIMD variant.
+        void DiscardSIMDVariant(llvm::Function& F);
+
         bool IsRegularGRFRequested() override;
         bool IsLargeGRFRequested() override;
         int getAnnotatedNumThreads() override;
@@ -413,6 +440,8 @@ namespace IGC
         bool m_largeGRFRequested;
         bool m_regularGRFRequested;
         int m_annotatedNumThreads;
+        // SIMD info bits set by the compile condition checks of this variant
+        uint64_t m_SIMDInfoFromCompileConds = 0;
 
         // Maps GlobalVariables representing local address-space pointers
         // to their offsets in SLM.
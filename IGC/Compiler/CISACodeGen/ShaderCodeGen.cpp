@@ -387,15 +387,15 @@ void AddLegalizationPasses(CodeGenContext& ctx, IGCPassManager& mpm, PSSignature
 
     if (highAllocaPressure || isPotentialHPCKernel)
     {
-        IGC_SET_FLAG_VALUE(FastCompileRA, 1);
-        IGC_SET_FLAG_VALUE(HybridRAWithSpill, 1);
+        ctx.m_ForceFastCompileRA = true;
+        ctx.m_ForceHybridRAWithSpill = true;
     }
     // In case of presence of Unmasked regions disable loop invariant motion after
     // Unmasked functions are inlined at the end of optimization phase
     if (IGC_IS_FLAG_ENABLED(EnableUnmaskedFunctions) &&
         IGC_IS_FLAG_DISABLED(LateInlineUnmaskedFunc) &&
         ctx.m_instrTypes.hasUnmaskedRegion) {
-        IGC_SET_FLAG_VALUE(allowLICM, false);
+        ctx.m_DisableLICM = true;
     }
 
     if (IGC_IS_FLAG_ENABLED(ForceAllPrivateMemoryToSLM) ||
@@ -456,7 +456,7 @@ void AddLegalizationPasses(CodeGenContext& ctx, IGCPassManager& mpm, PSSignature
 
         mpm.add(createBarrierNoopPass());
 
-        if (IGC_IS_FLAG_ENABLED(allowLICM) && ctx.m_retryManager.AllowLICM())
+        if (IGC_IS_FLAG_ENABLED(allowLICM) && !ctx.m_DisableLICM && ctx.m_retryManager.AllowLICM())
         {
             mpm.add(createDisableLICMForSpecificLoops());
             mpm.add(llvm::createLICMPass());
@@ -829,7 +829,7 @@ void AddLegalizationPasses(CodeGenContext& ctx, IGCPassManager& mpm, PSSignature
         {
             mpm.add(createSinkingPass());
         }
-        if (!fastCompile && !highAllocaPressure && !isPotentialHPCKernel && IGC_IS_FLAG_ENABLED(allowLICM) && ctx.m_retryManager.AllowLICM())
+        if (!fastCompile && !highAllocaPressure && !isPotentialHPCKernel && IGC_IS_FLAG_ENABLED(allowLICM) && !ctx.m_DisableLICM && ctx.m_retryManager.AllowLICM())
         {
             mpm.add(createDisableLICMForSpecificLoops());
             mpm.add(createLICMPass());
@@ -1399,7 +1399,7 @@ void OptimizeIR(CodeGenContext* const pContext)
                 mpm.add(llvm::createLCSSAPass());
                 mpm.add(llvm::createLoopSimplifyPass());
 
-                if (IGC_IS_FLAG_ENABLED(allowLICM) && pContext->m_retryManager.AllowLICM())
+                if (IGC_IS_FLAG_ENABLED(allowLICM) && !pContext->m_DisableLICM && pContext->m_retryManager.AllowLICM())
                 {
                     mpm.add(createDisableLICMForSpecificLoops());
                     int licmTh = IGC_GET_FLAG_VALUE(LICMStatThreshold);
@@ -1462,7 +1462,7 @@ void OptimizeIR(CodeGenContext* const pContext)
                 // LoopUnroll and LICM.
                 mpm.add(createBarrierNoopPass());
 
-                if (IGC_IS_FLAG_ENABLED(allowLICM) && pContext->m_retryManager.AllowLICM())
+                if (IGC_IS_FLAG_ENABLED(allowLICM) && !pContext->m_DisableLICM && pContext->m_retryManager.AllowLICM())
                 {
                     mpm.add(createDisableLICMForSpecificLoops());
                     mpm.add(llvm::createLICMPass());
@@ -1497,7 +1497,7 @@ void OptimizeIR(CodeGenContext* const pContext)
                     pContext->m_retryManager.IsFirstTry())
                 {
                     mpm.add(createGEPLoopStrengthReductionPass(IGC_IS_FLAG_ENABLED(allowLICM) &&
-                            pContext->m_retryManager.AllowLICM()));
+                            !pContext->m_DisableLICM && pContext->m_retryManager.AllowLICM()));
                 }
             }
 
@@ -714,6 +714,12 @@ namespace IGC
         this->oclWarningMessage << "\n";
     }
 
+    void CodeGenContext::AppendDiagnostics(CodeGenContext& other)
+    {
+        this->oclErrorMessage << other.GetError();
+        this->oclWarningMessage << other.GetWarning();
+    }
+
     CompOptions& CodeGenContext::getCompilerOption()
     {
         return getModuleMetaData()->compOpt;
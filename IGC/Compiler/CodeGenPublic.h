@@ -892,6 +892,12 @@ namespace IGC
         bool m_hasStackCalls = false;
         // Flag to determine if early Z culling should be called for certain patterns
         bool m_ForceEarlyZMathCheck = false;
+        // Set by codegen heuristics for this context only, in place of the
+        // FastCompileRA, HybridRAWithSpill and allowLICM regkeys, which
+        // contexts compiled on other threads read as well
+        bool m_ForceFastCompileRA = false;
+        bool m_ForceHybridRAWithSpill = false;
+        bool m_DisableLICM = false;
         // Adding multiversioning to partially redundant samples, if AIL is on.
         bool m_enableSampleMultiversioning = false;
 
@@ -1054,6 +1060,8 @@ namespace IGC
         void EmitError(std::ostream &OS, const char* errorstr, const llvm::Value *context) const;
         void EmitError(const char* errorstr, const llvm::Value *context);
         void EmitWarning(const char* warningstr);
+        // Appends the errors and warnings reported on another context
+        void AppendDiagnostics(CodeGenContext& other);
         inline bool HasError() const { return !this->oclErrorMessage.str().empty(); }
         inline bool HasWarning() const { return !this->oclWarningMessage.str().empty(); }
         inline const std::string GetWarning() { return this->oclWarningMessage.str(); }
@@ -1116,6 +1124,12 @@ namespace IGC
             m_SIMDInfo &= ~(0xffULL << offset);
         }
 
+        // Drops SIMD info bits recorded for a SIMD variant that got discarded
+        void ClearSIMDInfoBits(uint64_t bits)
+        {
+            m_SIMDInfo &= ~bits;
+        }
+
         uint64_t GetSIMDInfo() { return m_SIMDInfo; }
 
         virtual llvm::Optional<SIMDMode> knownSIMDSize() const {
@@ -26,9 +26,16 @@ SPDX-License-Identifier: MIT
 #include <llvm/Transforms/Utils/ValueMapper.h>
 #include <llvmWrapper/Transforms/Utils/Cloning.h>
 #include <llvm/Support/Error.h>
+#include <llvm/Support/MD5.h>
 #include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/xxhash.h>
 #include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include "common/LLVMWarningsPop.hpp"
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 #include "Probe/Assertion.h"
@@ -50,14 +57,201 @@ IGC_INITIALIZE_PASS_END(BIImport, PASS_FLAG, PASS_DESCRIPTION, PASS_CFG_ONLY, PA
 
 char BIImport::ID = 0;
 
-BIImport::BIImport(std::unique_ptr<Module> pGenericModule, std::unique_ptr<Module> pSizeModule) :
+namespace {
+/// Builtins imported by earlier translations in the process, as bitcode of the
+/// cleaned up builtin modules in the order they are linked. Parsing those is
+/// much cheaper than loading the builtin modules and walking their call graph.
+/// The cache is off unless both BuiltinImportCacheSize (entries) and
+/// BuiltinImportCacheSizeKB are set, and evicts the least recently used import
+/// beyond either limit.
+class BuiltinImportCache
+{
+public:
+    typedef std::vector<SmallVector<char, 0>> Entry;
+
+    static BuiltinImportCache& get()
+    {
+        static BuiltinImportCache cache;
+        return cache;
+    }
+
+    static bool isEnabled()
+    {
+        return IGC_GET_FLAG_VALUE(BuiltinImportCacheSize) > 0 &&
+            IGC_GET_FLAG_VALUE(BuiltinImportCacheSizeKB) > 0;
+    }
+
+    std::shared_ptr<const Entry> find(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            print("miss");
+            return nullptr;
+        }
+        // Move the import to the front of the LRU list
+        m_items.splice(m_items.begin(), m_items, it->second);
+        print("hit");
+        return it->second->entry;
+    }
+
+    void insert(const std::string& key, std::shared_ptr<const Entry> entry)
+    {
+        size_t size = key.size();
+        for (const auto& bitcode : *entry)
+        {
+            size += bitcode.size();
+        }
+        const size_t maxEntries = IGC_GET_FLAG_VALUE(BuiltinImportCacheSize);
+        const size_t maxSize = size_t(IGC_GET_FLAG_VALUE(BuiltinImportCacheSizeKB)) * 1024;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Another translation may have imported the same builtins meanwhile
+        if (m_index.count(key) || size > maxSize || maxEntries == 0)
+        {
+            return;
+        }
+        while (!m_items.empty() &&
+            (m_items.size() >= maxEntries || m_size + size > maxSize))
+        {
+            Item& lru = m_items.back();
+            print("evict", lru.size);
+            m_size -= lru.size;
+            m_index.erase(lru.key);
+            m_items.pop_back();
+        }
+        m_items.push_front(Item{ key, std::move(entry), size });
+        m_index.emplace(key, m_items.begin());
+        m_size += size;
+        print("insert", size);
+    }
+
+private:
+    struct Item
+    {
+        std::string key;
+        std::shared_ptr<const Entry> entry;
+        size_t size;
+    };
+
+    void print(const char* event, size_t size = 0) const
+    {
+        if (IGC_IS_FLAG_ENABLED(PrintBuiltinImportCache))
+        {
+            IGC::Debug::ods() << "BuiltinImportCache: " << event;
+            if (size)
+            {
+                IGC::Debug::ods() << " " << size << " bytes";
+            }
+            IGC::Debug::ods() << ", " << m_items.size() << " entries, " << m_size << " bytes cached\n";
+        }
+    }
+
+    std::mutex m_mutex;
+    // Most recently used first
+    std::list<Item> m_items;
+    std::unordered_map<std::string, std::list<Item>::iterator> m_index;
+    size_t m_size = 0;
+};
+} // namespace
+
+BIImport::BIImport(const MemoryBuffer* pGenericBuffer, const MemoryBuffer* pSizeBuffer) :
     ModulePass(ID),
-    m_GenericModule(std::move(pGenericModule)),
-    m_SizeModule(std::move(pSizeModule))
+    m_GenericBuffer(pGenericBuffer),
+    m_SizeBuffer(pSizeBuffer)
 {
     initializeBIImportPass(*PassRegistry::getPassRegistry());
 }
 
+bool BIImport::LoadBuiltinModules(Module& M)
+{
+    CodeGenContext* pCtx = getAnalysis<CodeGenContextWrapper>().getCodeGenContext();
+    COMPILER_TIME_START(pCtx, TIME_OCL_LazyBiFLoading);
+
+    Expected<std::unique_ptr<Module>> GenericOrErr =
+        getLazyBitcodeModule(m_GenericBuffer->getMemBufferRef(), M.getContext());
+    if (Error EC = GenericOrErr.takeError())
+    {
+        consumeError(std::move(EC));
+        pCtx->EmitError("Error lazily loading bitcode for generic builtins, "
+            "is bitcode the right version and correctly formed?", nullptr);
+        return false;
+    }
+    m_GenericModule = std::move(*GenericOrErr);
+
+    if (m_SizeBuffer)
+    {
+        Expected<std::unique_ptr<Module>> SizeOrErr =
+            getLazyBitcodeModule(m_SizeBuffer->getMemBufferRef(), M.getContext());
+        if (Error EC = SizeOrErr.takeError())
+        {
+            consumeError(std::move(EC));
+            pCtx->EmitError("Error lazily loading bitcode for size_t builtins", nullptr);
+            return false;
+        }
+        m_SizeModule = std::move(*SizeOrErr);
+        m_GenericModule->setTargetTriple(m_SizeModule->getTargetTriple());
+        m_SizeModule->setDataLayout(M.getDataLayout());
+    }
+    m_GenericModule->setDataLayout(M.getDataLayout());
+
+    COMPILER_TIME_END(pCtx, TIME_OCL_LazyBiFLoading);
+    return true;
+}
+
+std::string BIImport::GetImportCacheKey(Module& M) const
+{
+    // The builtins to import are the closure of the declarations M calls
+    std::vector<StringRef> calledDecls;
+    for (auto& F : M)
+    {
+        TFunctionsVec calledFuncs;
+        GetCalledFunctions(&F, calledFuncs);
+        for (auto* pCallee : calledFuncs)
+        {
+            if (pCallee->isDeclaration())
+            {
+                calledDecls.push_back(pCallee->getName());
+            }
+        }
+    }
+    std::sort(calledDecls.begin(), calledDecls.end());
+    calledDecls.erase(std::unique(calledDecls.begin(), calledDecls.end()), calledDecls.end());
+
+    MD5 hash;
+    auto hashBytes = [&hash](const void* pData, uint64_t size) {
+        hash.update(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(&size), sizeof(size)));
+        hash.update(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(pData), size));
+    };
+    auto hashString = [&hashBytes](StringRef str) {
+        hashBytes(str.data(), str.size());
+    };
+    // Tell the builtin modules apart by their contents: a buffer freed by one
+    // translation may be reallocated at the same address with other builtins.
+    // xxHash64 keeps hashing the whole bitcode cheap next to loading it.
+    auto hashBuffer = [&hashBytes](const MemoryBuffer* pBuffer) {
+        uint64_t contents[2] = {};
+        if (pBuffer)
+        {
+            contents[0] = pBuffer->getBufferSize();
+            contents[1] = xxHash64(pBuffer->getBuffer());
+        }
+        hashBytes(contents, sizeof(contents));
+    };
+    hashBuffer(m_GenericBuffer);
+    hashBuffer(m_SizeBuffer);
+    hashString(M.getDataLayoutStr());
+    for (StringRef name : calledDecls)
+    {
+        hashString(name);
+    }
+
+    MD5::MD5Result result;
+    hash.final(result);
+    return result.digest().str().str();
+}
+
 
 /* We have to run this step of updating mangled SPIR function names
 because of SPIR 1.2 specification issue. There are bugs in
@@ -588,7 +782,7 @@ void BIImport::fixInvalidBitcasts(llvm::Module &M)
 
 bool BIImport::runOnModule(Module& M)
 {
-    if (m_GenericModule == nullptr)
+    if (m_GenericBuffer == nullptr)
     {
         return false;
     }
@@ -629,93 +823,149 @@ bool BIImport::runOnModule(Module& M)
         }
     }
 
-    std::function<void(Function*)> Explore = [&](Function* pRoot) -> void
+    std::string cacheKey;
+    std::shared_ptr<const BuiltinImportCache::Entry> pCachedImport;
+    if (BuiltinImportCache::isEnabled())
     {
-        TFunctionsVec calledFuncs;
-        GetCalledFunctions(pRoot, calledFuncs);
+        cacheKey = GetImportCacheKey(M);
+        pCachedImport = BuiltinImportCache::get().find(cacheKey);
+    }
 
-        for (auto* pCallee : calledFuncs)
+    Linker ld(M);
+    if (pCachedImport)
+    {
+        for (const auto& bitcode : *pCachedImport)
         {
-            Function* pFunc = nullptr;
-            if (pCallee->isDeclaration())
+            MemoryBufferRef buffer(StringRef(bitcode.data(), bitcode.size()), "BiF");
+            Expected<std::unique_ptr<Module>> ModuleOrErr = parseBitcodeFile(buffer, M.getContext());
+            if (Error EC = ModuleOrErr.takeError())
             {
-                auto funcName = pCallee->getName();
-                Function* pSrcFunc = GetBuiltinFunction2(funcName);
-                if (!pSrcFunc) continue;
-                pFunc = pSrcFunc;
+                consumeError(std::move(EC));
+                IGC_ASSERT_MESSAGE(0, "Error loading cached builtin module");
+                return false;
             }
-            else
+            if (ld.linkInModule(std::move(*ModuleOrErr)))
             {
-                pFunc = pCallee;
+                IGC_ASSERT_MESSAGE(0, "Error linking cached builtin module");
             }
+        }
+    }
+    else
+    {
+        if (!LoadBuiltinModules(M))
+        {
+            return false;
+        }
 
-            if (pFunc->isMaterializable())
+        std::function<void(Function*)> Explore = [&](Function* pRoot) -> void
+        {
+            TFunctionsVec calledFuncs;
+            GetCalledFunctions(pRoot, calledFuncs);
+
+            for (auto* pCallee : calledFuncs)
             {
-                if (Error Err = pFunc->materialize()) {
-                    std::string Msg;
-                    handleAllErrors(std::move(Err), [&](ErrorInfoBase& EIB) {
-                        errs() << "===> Materialize Failure: " << EIB.message().c_str() << '\n';
-                    });
-                    IGC_ASSERT_MESSAGE(0, "Failed to materialize Global Variables");
+                Function* pFunc = nullptr;
+                if (pCallee->isDeclaration())
+                {
+                    auto funcName = pCallee->getName();
+                    Function* pSrcFunc = GetBuiltinFunction2(funcName);
+                    if (!pSrcFunc) continue;
+                    pFunc = pSrcFunc;
                 }
-                else {
-                    pFunc->addFnAttr("OclBuiltin");
-                    Explore(pFunc);
+                else
+                {
+                    pFunc = pCallee;
                 }
-            }
 
-            if (pFunc->getName().startswith("__builtin_IB_kmp_"))
-            {
-                pFunc->addFnAttr(llvm::Attribute::NoInline);
-                pFunc->addFnAttr("KMPLOCK");
+                if (pFunc->isMaterializable())
+                {
+                    if (Error Err = pFunc->materialize()) {
+                        std::string Msg;
+                        handleAllErrors(std::move(Err), [&](ErrorInfoBase& EIB) {
+                            errs() << "===> Materialize Failure: " << EIB.message().c_str() << '\n';
+                        });
+                        IGC_ASSERT_MESSAGE(0, "Failed to materialize Global Variables");
+                    }
+                    else {
+                        pFunc->addFnAttr("OclBuiltin");
+                        Explore(pFunc);
+                    }
+                }
+
+                if (pFunc->getName().startswith("__builtin_IB_kmp_"))
+                {
+                    pFunc->addFnAttr(llvm::Attribute::NoInline);
+                    pFunc->addFnAttr("KMPLOCK");
+                }
             }
-        }
-    };
+        };
 
-    for (auto& func : M)
-    {
-        Explore(&func);
-    }
+        for (auto& func : M)
+        {
+            Explore(&func);
+        }
 
-    // nuke the unused functions so we can materializeAll() quickly
-    auto CleanUnused = [](Module* Module)
-    {
-        for (auto I = Module->begin(), E = Module->end(); I != E; )
+        // nuke the unused functions so we can materializeAll() quickly
+        auto CleanUnused = [](Module* Module)
         {
-            auto* F = &(*I++);
-            if (F->isDeclaration() || F->isMaterializable())
+            for (auto I = Module->begin(), E = Module->end(); I != E; )
             {
-                if (materialized_use_empty(F))
+                auto* F = &(*I++);
+                if (F->isDeclaration() || F->isMaterializable())
                 {
-                    F->eraseFromParent();
+                    if (materialized_use_empty(F))
+                    {
+                        F->eraseFromParent();
+                    }
                 }
             }
+        };
+
+        std::shared_ptr<BuiltinImportCache::Entry> pImport;
+        if (!cacheKey.empty())
+        {
+            pImport = std::make_shared<BuiltinImportCache::Entry>();
         }
-    };
+        auto saveImport = [&pImport](const Module& importedModule)
+        {
+            if (pImport)
+            {
+                pImport->emplace_back();
+                raw_svector_ostream OStream(pImport->back());
+                WriteBitcodeToFile(importedModule, OStream);
+            }
+        };
 
-    CleanUnused(m_GenericModule.get());
-    Linker ld(M);
+        CleanUnused(m_GenericModule.get());
 
-    if (Error err = m_GenericModule->materializeAll()) {
-        IGC_ASSERT_MESSAGE(0, "materializeAll failed for generic builtin module");
-    }
+        if (Error err = m_GenericModule->materializeAll()) {
+            IGC_ASSERT_MESSAGE(0, "materializeAll failed for generic builtin module");
+        }
 
-    if (ld.linkInModule(std::move(m_GenericModule)))
-    {
-        IGC_ASSERT_MESSAGE(0, "Error linking generic builtin module");
-    }
+        saveImport(*m_GenericModule);
+        if (ld.linkInModule(std::move(m_GenericModule)))
+        {
+            IGC_ASSERT_MESSAGE(0, "Error linking generic builtin module");
+        }
 
-    if (m_SizeModule)
-    {
-        CleanUnused(m_SizeModule.get());
-        if (Error err = m_SizeModule->materializeAll())
+        if (m_SizeModule)
         {
-            IGC_ASSERT_MESSAGE(0, "materializeAll failed for size_t builtin module");
+            CleanUnused(m_SizeModule.get());
+            if (Error err = m_SizeModule->materializeAll())
+            {
+                IGC_ASSERT_MESSAGE(0, "materializeAll failed for size_t builtin module");
+            }
+
+            saveImport(*m_SizeModule);
+            if (ld.linkInModule(std::move(m_SizeModule)))
+            {
+                IGC_ASSERT_MESSAGE(0, "Error linking size_t builtin module");
+            }
         }
 
-        if (ld.linkInModule(std::move(m_SizeModule)))
+        if (pImport)
         {
-            IGC_ASSERT_MESSAGE(0, "Error linking size_t builtin module");
+            BuiltinImportCache::get().insert(cacheKey, std::move(pImport));
         }
     }
 
@@ -1140,10 +1390,10 @@ void BIImport::InitializeBIFlags(Module& M)
 }
 
 extern "C" llvm::ModulePass* createBuiltInImportPass(
-    std::unique_ptr<Module> pGenericModule,
-    std::unique_ptr<Module> pSizeModule)
+    const MemoryBuffer* pGenericBuffer,
+    const MemoryBuffer* pSizeBuffer)
 {
-    return new BIImport(std::move(pGenericModule), std::move(pSizeModule));
+    return new BIImport(pGenericBuffer, pSizeBuffer);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 
 #include "common/LLVMWarningsPush.hpp"
 #include <llvm/Pass.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include "common/LLVMWarningsPop.hpp"
 
 #include "AdaptorOCL/CLElfLib/ElfReader.h"
@@ -35,8 +36,12 @@ namespace IGC
         static char ID;
 
         /// @brief Constructor
-        BIImport(std::unique_ptr<llvm::Module> pGenericModule = nullptr,
-            std::unique_ptr<llvm::Module> pSizeModule = nullptr);
+        /// @param pGenericBuffer The bitcode of the generic builtin module.
+        /// @param pSizeBuffer The bitcode of the size_t builtin module, optional.
+        ///        The modules are only loaded if the builtins the destination
+        ///        module needs can't be taken from the import cache.
+        BIImport(const llvm::MemoryBuffer* pGenericBuffer = nullptr,
+            const llvm::MemoryBuffer* pSizeBuffer = nullptr);
 
         /// @brief analyses used
         virtual void getAnalysisUsage(llvm::AnalysisUsage& AU) const override
@@ -68,6 +73,13 @@ namespace IGC
         ///         the BiFs are linked. We can remove this code once llvm implements typeless pointers.
         void removeFunctionBitcasts(llvm::Module& M);
 
+        /// @brief  Lazily load the builtin modules into the context of M.
+        bool LoadBuiltinModules(llvm::Module& M);
+
+        /// @brief  Get the key of the import cache entry for M. The imported builtins
+        ///         only depend on the builtins M calls, its data layout and the builtin bitcode.
+        std::string GetImportCacheKey(llvm::Module& M) const;
+
         /// @brief  Initialize values for global flags needed for the built-ins (FlushDenormal).
         ///         Only initializes flags that the built-ins need.
         void InitializeBIFlags(llvm::Module& M);
@@ -87,6 +99,10 @@ namespace IGC
         void fixInvalidBitcasts(llvm::Module& M);
 
     protected:
+        /// Bitcode of the builtin modules
+        const llvm::MemoryBuffer* m_GenericBuffer;
+        const llvm::MemoryBuffer* m_SizeBuffer;
+
         /// Builtin module - contains the source function definition to import
         std::unique_ptr<llvm::Module> m_GenericModule;
         std::unique_ptr<llvm::Module> m_SizeModule;
@@ -95,7 +111,7 @@ namespace IGC
 } // namespace IGC
 
 extern "C" llvm::ModulePass* createBuiltInImportPass(
-    std::unique_ptr<llvm::Module> pGenericModule, std::unique_ptr<llvm::Module> pSizeModule);
+    const llvm::MemoryBuffer* pGenericBuffer, const llvm::MemoryBuffer* pSizeBuffer);
 
 namespace IGC
 {
@@ -0,0 +1,32 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef IGCLLVM_SUPPORT_THREADPOOL_H
+#define IGCLLVM_SUPPORT_THREADPOOL_H
+
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+
+#include <memory>
+
+namespace IGCLLVM {
+    // Creates a pool with the given number of worker threads. A value of 0
+    // lets LLVM pick the number of hardware threads.
+    inline std::unique_ptr<llvm::ThreadPool> createThreadPool(unsigned ThreadCount)
+    {
+#if LLVM_VERSION_MAJOR < 11
+        if (ThreadCount == 0)
+            ThreadCount = llvm::hardware_concurrency();
+        return std::make_unique<llvm::ThreadPool>(ThreadCount);
+#else
+        return std::make_unique<llvm::ThreadPool>(llvm::hardware_concurrency(ThreadCount));
+#endif
+    }
+} // namespace IGCLLVM
+
+#endif // IGCLLVM_SUPPORT_THREADPOOL_H
@@ -22,12 +22,55 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPop.hpp"
 #endif
 
+#include <cstring>
 #include <iostream>
 #include <tuple>
 #include "Probe/Assertion.h"
 
 namespace zebin {
 
+namespace {
+
+/// SizeCountingStream - A raw_pwrite_stream that only counts the bytes written
+///                      to it, used to size the ELF before it is written
+class SizeCountingStream : public llvm::raw_pwrite_stream {
+public:
+    SizeCountingStream() : llvm::raw_pwrite_stream(/*Unbuffered=*/true) {}
+
+private:
+    void write_impl(const char* Ptr, size_t Size) override { m_pos += Size; }
+    void pwrite_impl(const char* Ptr, size_t Size, uint64_t Offset) override {}
+    uint64_t current_pos() const override { return m_pos; }
+
+    uint64_t m_pos = 0;
+};
+
+/// FixedBufferStream - A raw_pwrite_stream writing into a caller-owned buffer
+///                     whose size is known up front
+class FixedBufferStream : public llvm::raw_pwrite_stream {
+public:
+    FixedBufferStream(uint8_t* buffer, uint64_t size)
+        : llvm::raw_pwrite_stream(/*Unbuffered=*/true), m_buffer(buffer), m_size(size) {}
+
+private:
+    void write_impl(const char* Ptr, size_t Size) override {
+        IGC_ASSERT(m_pos + Size <= m_size);
+        memcpy(m_buffer + m_pos, Ptr, Size);
+        m_pos += Size;
+    }
+    void pwrite_impl(const char* Ptr, size_t Size, uint64_t Offset) override {
+        IGC_ASSERT(Offset + Size <= m_pos);
+        memcpy(m_buffer + Offset, Ptr, Size);
+    }
+    uint64_t current_pos() const override { return m_pos; }
+
+    uint8_t* m_buffer;
+    uint64_t m_size;
+    uint64_t m_pos = 0;
+};
+
+} // namespace
+
 /// ELFWriter - A helper class to write ELF contents into given raw_pwrite_stream,
 ///             according to the given ZEELFObjectBuilder. This object should
 ///             only be used by ZEELFObjectBuilder
@@ -375,6 +418,30 @@ uint64_t ZEELFObjectBuilder::finalize(llvm::raw_pwrite_stream& os)
     return w.write();
 }
 
+uint64_t ZEELFObjectBuilder::getBinarySize()
+{
+    SizeCountingStream os;
+    return finalize(os);
+}
+
+uint64_t ZEELFObjectBuilder::finalize(uint8_t* buffer, uint64_t size)
+{
+    FixedBufferStream os(buffer, size);
+    return finalize(os);
+}
+
+const std::string& ZEELFObjectBuilder::ZEInfoSection::getYaml()
+{
+    if (!m_serialized) {
+        llvm::raw_string_ostream os(m_yaml);
+        llvm::yaml::Output yout(os);
+        yout << m_zeinfo;
+        os.flush();
+        m_serialized = true;
+    }
+    return m_yaml;
+}
+
 ZEELFObjectBuilder::SectionID
 ZEELFObjectBuilder::getSectionIDBySectionName(const char* name)
 {
@@ -570,10 +637,8 @@ uint64_t ELFWriter::writeSymTab()
 uint64_t ELFWriter::writeZEInfo()
 {
     uint64_t start_off = m_W.OS.tell();
-    // serialize ze_info contents
-    llvm::yaml::Output yout(m_W.OS);
     IGC_ASSERT(m_ObjBuilder.m_zeInfoSection);
-    yout << m_ObjBuilder.m_zeInfoSection->getZeInfo();
+    m_W.OS << m_ObjBuilder.m_zeInfoSection->getYaml();
 
     return m_W.OS.tell() - start_off;
 }
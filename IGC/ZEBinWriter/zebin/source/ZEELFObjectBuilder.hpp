@@ -219,6 +219,14 @@ public:
     // return number of written bytes
     uint64_t finalize(llvm::raw_pwrite_stream& os);
 
+    // getBinarySize - the number of bytes finalize will write, computed
+    // without copying any section data
+    uint64_t getBinarySize();
+
+    // finalize - Finalize the ELF Object into the given buffer, which must be
+    // at least getBinarySize() bytes. Return number of written bytes
+    uint64_t finalize(uint8_t* buffer, uint64_t size);
+
     // get an ID of a section
     // - name  : section name
     SectionID getSectionIDBySectionName(const char* name);
@@ -273,8 +281,14 @@ private:
         zeInfoContainer& getZeInfo()
         { return m_zeinfo; }
 
+        // ze_info serialized in yaml format, done once so that sizing and
+        // writing the object do not serialize it again
+        const std::string& getYaml();
+
     private:
         zeInfoContainer& m_zeinfo;
+        std::string m_yaml;
+        bool m_serialized = false;
     };
 
     class Symbol {
@@ -36,6 +36,12 @@ extern "C" unsigned int getTimerHits(unsigned int idx);
 extern "C" unsigned int getTotalTimers();
 #endif
 
+extern "C" void vISAEnableTraceEvents(const char* fileName);
+extern "C" bool vISATraceEventsEnabled();
+extern "C" void vISABeginTraceEvent(const char* name, const char* category);
+extern "C" void vISAEndTraceEvent(const char* name);
+extern "C" void vISAWriteTraceEvents();
+
 namespace {
     static const unsigned g_cIndentSZ = 4; //<! number of spaces to indent by
 }
@@ -399,6 +405,35 @@ int parentIntervalDepth( COMPILE_TIME_INTERVALS cti )
     }
 }
 
+bool IGC::TraceEventsEnabled()
+{
+    return vISATraceEventsEnabled();
+}
+
+void IGC::TraceEventBegin(const std::string& name, const char* category)
+{
+    vISABeginTraceEvent(name.c_str(), category);
+}
+
+void IGC::TraceEventEnd(const std::string& name)
+{
+    vISAEndTraceEvent(name.c_str());
+}
+
+IGC::TraceEventsOutput::TraceEventsOutput()
+{
+    const char* fileName = IGC_GET_REGKEYSTRING(TraceEventsFile);
+    if (fileName && fileName[0] != '\0')
+    {
+        vISAEnableTraceEvents(fileName);
+    }
+}
+
+IGC::TraceEventsOutput::~TraceEventsOutput()
+{
+    vISAWriteTraceEvents();
+}
+
 #if GET_TIME_STATS
 
 TimeStats::TimeStats()
@@ -429,6 +464,26 @@ void TimeStats::recordVISATimers()
     }
 }
 
+void TimeStats::recordVISATimers(const VISATimerValues& values)
+{
+    for (unsigned int i = 0; i < values.ticks.size(); ++i)
+    {
+        m_elapsedTime[TIME_VISA_TOTAL + i] += values.ticks[i];
+        m_hitCount[TIME_VISA_TOTAL + i] = values.hits[i];
+    }
+}
+
+VISATimerValues TimeStats::readVISATimers()
+{
+    VISATimerValues values;
+    for (unsigned int i = 0; i < getTotalTimers(); ++i)
+    {
+        values.ticks.push_back(getTimerTicks(i));
+        values.hits.push_back(getTimerHits(i));
+    }
+    return values;
+}
+
 void TimeStats::recordTimerStart( COMPILE_TIME_INTERVALS compileInterval )
 {
     IGC_ASSERT(0 <= compileInterval);
@@ -30,6 +30,8 @@ SPDX-License-Identifier: MIT
 
 #include <string>
 #include <map>
+#include <vector>
+#include <utility>
 
 namespace llvm
 {
@@ -184,6 +186,52 @@ bool isDashboardTimer( COMPILE_TIME_INTERVALS cti );
 COMPILE_TIME_INTERVALS parentInterval( COMPILE_TIME_INTERVALS cti );
 int parentIntervalDepth( COMPILE_TIME_INTERVALS cti );
 
+namespace IGC
+{
+    /// Spans of the timeline written in the Chrome trace-event format to the
+    /// file given by the TraceEventsFile regkey. It is kept by vISA, which
+    /// records a span for every run of its timers on the same timeline. Spans
+    /// are recorded per thread and need not nest. The category must be a
+    /// string literal.
+    bool TraceEventsEnabled();
+    void TraceEventBegin(const std::string& name, const char* category);
+    void TraceEventEnd(const std::string& name);
+
+    class TraceEventScope
+    {
+    public:
+        TraceEventScope(std::string name, const char* category)
+            : m_name(std::move(name)), m_enabled(TraceEventsEnabled())
+        {
+            if (m_enabled)
+                TraceEventBegin(m_name, category);
+        }
+        ~TraceEventScope()
+        {
+            if (m_enabled)
+                TraceEventEnd(m_name);
+        }
+        TraceEventScope(const TraceEventScope&) = delete;
+        TraceEventScope& operator=(const TraceEventScope&) = delete;
+
+    private:
+        std::string m_name;
+        bool m_enabled;
+    };
+
+    /// TraceEventsOutput - Placed around a top-level compile, enables the
+    /// timeline if the TraceEventsFile regkey is set and writes it when the
+    /// compile is done.
+    class TraceEventsOutput
+    {
+    public:
+        TraceEventsOutput();
+        ~TraceEventsOutput();
+        TraceEventsOutput(const TraceEventsOutput&) = delete;
+        TraceEventsOutput& operator=(const TraceEventsOutput&) = delete;
+    };
+}
+
 #if GET_TIME_STATS
 
 struct PerPassTimeStat
@@ -193,6 +241,13 @@ struct PerPassTimeStat
     int PassHitCount = 0;
 };
 
+/// vISA timer values of one compile, taken on the thread that ran it
+struct VISATimerValues
+{
+    std::vector<int64_t> ticks;
+    std::vector<unsigned int> hits;
+};
+
 class TimeStats
 {
 public:
@@ -201,6 +256,11 @@ public:
 
     /// Capture the VISA timer values for the most recent call to VISABuilder::compile()
     void recordVISATimers();
+    /// Same, for a compile that ran on another thread, see readVISATimers()
+    void recordVISATimers(const VISATimerValues& values);
+    /// Read the VISA timers of the calling thread. vISA keeps one set of timers
+    /// per thread, so a compile handed to a worker thread is measured there.
+    static VISATimerValues readVISATimers();
 
     /// Mark that a particular timer has started timing
     void recordTimerStart( COMPILE_TIME_INTERVALS compileInterval );
@@ -282,6 +342,10 @@ private:
         { \
                 (pointer)->m_compilerTimeStats->recordTimerStart( compileTimeInterval );  \
         } \
+        if( IGC::TraceEventsEnabled() ) \
+        { \
+            IGC::TraceEventBegin( g_cCompTimeIntervals[compileTimeInterval], "IGC" ); \
+        } \
     } while (0)
 #define COMPILER_TIME_END( pointer, compileTimeInterval ) \
     do \
@@ -290,6 +354,10 @@ private:
         { \
                 (pointer)->m_compilerTimeStats->recordTimerEnd( compileTimeInterval ); \
         } \
+        if( IGC::TraceEventsEnabled() ) \
+        { \
+            IGC::TraceEventEnd( g_cCompTimeIntervals[compileTimeInterval] ); \
+        } \
     } while (0)
 
 #define COMPILER_TIME_PASS_START( pointer, name ) \
@@ -299,6 +367,10 @@ private:
         { \
                 (pointer)->m_compilerTimeStats->recordPerPassTimerStart( name );  \
         } \
+        if( IGC::TraceEventsEnabled() ) \
+        { \
+            IGC::TraceEventBegin( name, "IGC pass" ); \
+        } \
     } while (0)
 #define COMPILER_TIME_PASS_END( pointer, name ) \
     do \
@@ -307,6 +379,10 @@ private:
         { \
                 (pointer)->m_compilerTimeStats->recordPerPassTimerEnd( name ); \
         } \
+        if( IGC::TraceEventsEnabled() ) \
+        { \
+            IGC::TraceEventEnd( name ); \
+        } \
     } while (0)
 
 #define COMPILER_TIME_SUM( pointerDst, pointerSrc ) \
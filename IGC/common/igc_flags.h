@@ -48,6 +48,7 @@ DECLARE_IGC_REGKEY(DWORD, EnableVISAStructurizer,       1,     "Enable/Disable V
 DECLARE_IGC_REGKEY(bool, EnableVISAJmpi,                true,  "Enable/Disable VISA generating jmpi (scalar jump).", false)
 DECLARE_IGC_REGKEY(bool, ForceVISAStructurizer,         false, "Force VISA structurizer for testing. Used on platforms in which we turns off SCF and use UCF by default", false)
 DECLARE_IGC_REGKEY(bool, EnableVISABoundsChecking,      true,  "Enable VISA bounds checking.", false)
+DECLARE_IGC_REGKEY(bool, EnableInlineVISAAsmMerge,      false, "Parse inline vISA asm and linked vISA asm into the in-memory vISA kernel instead of printing the whole kernel as vISA text and parsing it again", false)
 DECLARE_IGC_REGKEY(bool, NoMaskWA,                      true,  "Enable NoMask WA by using software-computed emask flag", false)
 DECLARE_IGC_REGKEY(bool, ForceNoMaskWA,                 false, "[tmp, testing] Force NoMaskWA on any platforms", false)
 DECLARE_IGC_REGKEY(bool, EnableCallWA,                  true,  "Control call WA when EU fusion is on. 0: off; 1: on", true)
@@ -283,6 +284,8 @@ DECLARE_IGC_REGKEY(bool, EnableZeroSomeARF,             false,  "If set, insert
 DECLARE_IGC_REGKEY(DWORD, ShaderDisableOptPassesAfter,  0,     "Will only run first N optimization passes, any further passes will be ignored. This flag can be used to bisect optimization passes.", false)
 DECLARE_IGC_REGKEY(bool, ShaderOverride,                false, "Will override any LLVM shader with matching name in c:\\Intel\\IGC\\ShaderOverride", false)
 DECLARE_IGC_REGKEY(bool, CompileOneAtTime,              false, "Compile only one kernel (out of many in llvm::module) at a time. Prints compiled kenrels names to stdout. Useful to debug compilation time and crashes - it does not produce valid binary.", false)
+DECLARE_IGC_REGKEY(bool, EnableParallelKernelCompile,   false, "Compile each kernel of a unified OpenCL program on its own LLVMContext on worker threads. Only used for zebin programs without program-scope globals after unification", true)
+DECLARE_IGC_REGKEY(DWORD, ParallelKernelCompileThreads, 0,     "Number of worker threads used by EnableParallelKernelCompile. 0 : one thread per hardware core", false)
 DECLARE_IGC_REGKEY(bool, SystemThreadEnable,            false, "This key forces software to create a system thread. The system thread may still be created by software even \
                                                                 if this control is set to false.The system thread is invoked if either the software requires \
                                                                 exception handling or if kernel debugging is active and a breakpoint is hit.", false)
@@ -369,6 +372,7 @@ DECLARE_IGC_REGKEY(bool, EnableScalarizerDebugLog,      false, "print step by st
 DECLARE_IGC_REGKEY(bool, DumpTimeStats,                 false, "Timing of translation, code generation, finalizer, etc", true)
 DECLARE_IGC_REGKEY(bool, DumpTimeStatsCoarse,           false, "Only collect/dump coarse level time stats, i.e. skip opt detail timer for now", true)
 DECLARE_IGC_REGKEY(bool, DumpTimeStatsPerPass,          false, "Collect Timing of IGC/LLVM passes", true)
+DECLARE_IGC_REGKEY(debugString, TraceEventsFile,      0,     "Write a timeline of IGC intervals, IGC/LLVM passes, EmitVISAPass per function and SIMD size, retry states and vISA timers to this file in Chrome trace-event format", true)
 DECLARE_IGC_REGKEY(bool, DumpHasNonKernelArgLdSt,       false, "Print if hasNonKernelArg load/store to stderr", true)
 DECLARE_IGC_REGKEY(bool, PrintPsoDdiHash,               true,  "Print psoDDIHash in TimeStats_Shaders.csv file", true)
 DECLARE_IGC_REGKEY(bool, ShaderDataBaseStats,           false, "Enable gathering sends' sizes for shader statistics", false)
@@ -408,6 +412,14 @@ DECLARE_IGC_REGKEY(bool, EnableOCLSIMD16,               true,  "Enable OCL SIMD1
 DECLARE_IGC_REGKEY(bool, EnableOCLSIMD32,               true,  "Enable OCL SIMD32 mode", true)
 DECLARE_IGC_REGKEY(DWORD, ForceOCLSIMDWidth,            0,     "Force using SIMD width specified. 0 : no forcing. This overrides driver forced SIMD value(if any) and runtime behaviour could be different if driver expects something fixed", true)
 DECLARE_IGC_REGKEY(bool, SendMultipleSIMDModesCS,       true,  "Send multiple SIMD modes for CS", false)
+DECLARE_IGC_REGKEY(bool, EnableParallelSIMDVariantCompile, false, "Emit all SIMD variants of an OpenCL kernel up front and run their vISA compiles on worker threads. The selected variant is the same as in the serial path, and variants superseded by a compiled wider variant are not compiled", true)
+DECLARE_IGC_REGKEY(DWORD, ParallelSIMDVariantCompileThreads, 0, "Number of worker threads used by EnableParallelSIMDVariantCompile. 0 : one thread per hardware core", false)
+DECLARE_IGC_REGKEY(bool, EnableKernelCache,             false, "Keep OpenCL program binaries in an on-disk cache keyed by the input, options, platform and IGC revision, and return them without compiling on a hit", true)
+DECLARE_IGC_REGKEY(debugString, KernelCacheDir,         0,     "Directory of the EnableKernelCache cache. Empty : igc in the user cache directory", true)
+DECLARE_IGC_REGKEY(DWORD, KernelCacheMaxSizeMB,         1024,  "Size limit of the EnableKernelCache cache in MB. Least recently used entries are evicted beyond it. 0 : no limit", true)
+DECLARE_IGC_REGKEY(DWORD, BuiltinImportCacheSize,       0,     "Number of builtin imports an OCL process keeps to link into later programs calling the same builtins. Needs BuiltinImportCacheSizeKB too. 0 : disabled", true)
+DECLARE_IGC_REGKEY(DWORD, BuiltinImportCacheSizeKB,     0,     "Size limit of the builtin import cache in KB. Least recently used imports are evicted beyond it or beyond BuiltinImportCacheSize. 0 : disabled", true)
+DECLARE_IGC_REGKEY(bool, PrintBuiltinImportCache,       false, "Print builtin import cache hits, misses and evictions, needs PrintToConsole", true)
 DECLARE_IGC_REGKEY(DWORD, OCLSIMD16SelectionMask,       6,     "Select SIMD 16 heuristics. Valid values are 0, 1, 2 and 3", false)
 DECLARE_IGC_REGKEY(bool, EnableHSSinglePatchDispatch,   false, "Setting this to 1/true enables SIMD8 single-patch dispatch in HullShader. Default is either SIMD8 single patch/dual patch dispatch based on control point count", false)
 DECLARE_IGC_REGKEY(bool, DisableGPGPUIndirectPayload,   false, "Disable OCL indirect GPGPU payload", false)
@@ -433,6 +445,7 @@ DECLARE_IGC_REGKEY(bool, EnablePreRARematFlag,          true,  "Enable PreRA Rem
 DECLARE_IGC_REGKEY(bool, EnableGASResolver,             true,  "Enable GAS Resolver", false)
 DECLARE_IGC_REGKEY(bool, EnableLowerGPCallArg,          true,  "Enable pass to lower generic pointers in function arguments", false)
 DECLARE_IGC_REGKEY(bool, DisableRecompilation,          false, "Disable recompilation", true)
+DECLARE_IGC_REGKEY(bool, EnableRetryFromUnifiedModule,  false, "Restart OCL recompilation from the module saved after unification instead of parsing the input again", false)
 DECLARE_IGC_REGKEY(bool, SampleMultiversioning,         false, "Create branches aroung samplers which can be redundant with some values", false)
 DECLARE_IGC_REGKEY(bool, EnableSMRescheduling,          false, "Change instruction order to enable extra Sample Multiversioning cases", false)
 DECLARE_IGC_REGKEY(bool, DisableEarlyOutPatterns,       false, "Disable optimization trying to create an early out after sampleC messages", false)
@@ -718,6 +731,7 @@ DECLARE_IGC_REGKEY(bool, DisableFastRAWA, true, "Disable Fast RA for hanging iss
 DECLARE_IGC_REGKEY(bool, FastCompileRA, false, "Provide the fast compilatoin path for RA, fail safe at first iteration", false)
 DECLARE_IGC_REGKEY(bool, HybridRAWithSpill, false, "Did Hybrid RA with Spill", false)
 DECLARE_IGC_REGKEY(bool, SelectiveFastRA, false, "Apply fast RA with spills selectively using heuristics", true)
+DECLARE_IGC_REGKEY(DWORD, CompileTimeBudgetMs, 0, "Target compile time in milliseconds. Compilation switches to cheaper strategies (no SIMD32, no pre-RA scheduling, fast RA, early fail safe RA) for kernels too large for the budget. 0 disables it", true)
 DECLARE_IGC_REGKEY(DWORD, AllowStackCallRetry, 2, "Enable/Disable retry when stack function spill. 0 - Don't allow, 1 - Allow retry on kernel group, 2 - Allow retry per function", false)
 DECLARE_IGC_REGKEY(bool, PrintStackCallDebugInfo, false, "Print all debug info to command line related to stack call debugging", true)
 DECLARE_IGC_REGKEY(DWORD, StripDebugInfo, 0,
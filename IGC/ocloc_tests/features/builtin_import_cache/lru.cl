@@ -0,0 +1,62 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test builds the kernel several times in one ocloc process, each time
+// calling a different builtin, and checks the hits, misses and least
+// recently used evictions of the builtin import cache.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: echo "-file %s -device dg2 -out_dir %t -options -DFUNC=sin" > %t/lru.txt
+// RUN: echo "-file %s -device dg2 -out_dir %t -options -DFUNC=cos" >> %t/lru.txt
+// RUN: echo "-file %s -device dg2 -out_dir %t -options -DFUNC=sin" >> %t/lru.txt
+// RUN: echo "-file %s -device dg2 -out_dir %t -options -DFUNC=tan" >> %t/lru.txt
+// RUN: echo "-file %s -device dg2 -out_dir %t -options -DFUNC=sin" >> %t/lru.txt
+// RUN: echo "-file %s -device dg2 -out_dir %t -options -DFUNC=cos" >> %t/lru.txt
+// RUN: env IGC_PrintToConsole=1 IGC_PrintBuiltinImportCache=1 IGC_BuiltinImportCacheSize=2 IGC_BuiltinImportCacheSizeKB=16384 ocloc multi %t/lru.txt 2>&1 | FileCheck %s --check-prefix=CHECK-LRU
+
+// sin
+// CHECK-LRU: BuiltinImportCache: miss, 0 entries
+// CHECK-LRU: BuiltinImportCache: insert {{[0-9]+}} bytes, 1 entries
+// cos
+// CHECK-LRU: BuiltinImportCache: miss, 1 entries
+// CHECK-LRU: BuiltinImportCache: insert {{[0-9]+}} bytes, 2 entries
+// sin
+// CHECK-LRU: BuiltinImportCache: hit, 2 entries
+// tan evicts cos, which was used less recently than sin
+// CHECK-LRU: BuiltinImportCache: miss, 2 entries
+// CHECK-LRU: BuiltinImportCache: evict {{[0-9]+}} bytes, 2 entries
+// CHECK-LRU: BuiltinImportCache: insert {{[0-9]+}} bytes, 2 entries
+// sin
+// CHECK-LRU: BuiltinImportCache: hit, 2 entries
+// cos
+// CHECK-LRU: BuiltinImportCache: miss, 2 entries
+// CHECK-LRU: BuiltinImportCache: evict {{[0-9]+}} bytes, 2 entries
+// CHECK-LRU: BuiltinImportCache: insert {{[0-9]+}} bytes, 2 entries
+// CHECK-LRU-NOT: BuiltinImportCache
+
+// An import larger than the size limit is not cached.
+// RUN: echo "-file %s -device dg2 -out_dir %t -options -DFUNC=sin" > %t/size.txt
+// RUN: echo "-file %s -device dg2 -out_dir %t -options -DFUNC=sin" >> %t/size.txt
+// RUN: env IGC_PrintToConsole=1 IGC_PrintBuiltinImportCache=1 IGC_BuiltinImportCacheSize=64 IGC_BuiltinImportCacheSizeKB=1 ocloc multi %t/size.txt 2>&1 | FileCheck %s --check-prefix=CHECK-SIZE
+
+// CHECK-SIZE: BuiltinImportCache: miss, 0 entries
+// CHECK-SIZE-NOT: insert
+// CHECK-SIZE: BuiltinImportCache: miss, 0 entries
+// CHECK-SIZE-NOT: BuiltinImportCache
+
+// The cache is off by default.
+// RUN: env IGC_PrintToConsole=1 IGC_PrintBuiltinImportCache=1 ocloc multi %t/size.txt 2>&1 | FileCheck %s --allow-empty --check-prefix=CHECK-OFF
+
+// CHECK-OFF-NOT: BuiltinImportCache
+
+kernel void test(global float* buf) {
+  int gid = get_global_id(0);
+  buf[gid] = FUNC(buf[gid]);
+}
@@ -0,0 +1,31 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that disassembling a kernel larger than 128KB with
+// -Xparallel, which decodes it in several chunks and formats it in several
+// slices, gives the same text as the serial disassembly. The thread count is
+// set so that the kernel is split however many threads the host has. The kernel mixes
+// compacted and full instructions, so chunks are cut at both sizes, and has
+// forward jumps across chunks, so labels are inferred over the whole kernel.
+
+// REQUIRES: iga
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: %python -c "import sys; sys.stdout.write(''.join(('L%%d:\n(W) jmpi L%%d\n' %% (i, i + 256) if i %% 256 == 0 else '') + '(W) add (8|M0) r%%d.0<1>:d r%%d.0<8;8,1>:d %%d:d\n(W) mov (16|M0) r%%d.0<1>:f r%%d.0<1;1,0>:f\n' %% (10 + i %% 50, 70 + i %% 50, i, 10 + i %% 50, 70 + i %% 50) for i in range(12288)) + 'L12288:\n(W) nop\n')" > %t/large.asm
+// RUN: %iga -p=xehpg -a -Xautocompact %t/large.asm -o %t/large.krn
+// RUN: %python -c "import os, sys; sys.exit(os.path.getsize(sys.argv[1]) <= 128 * 1024)" %t/large.krn
+// RUN: %iga -p=xehpg -d %t/large.krn -o %t/serial.asm
+// RUN: %iga -p=xehpg -d -Xparallel-threads=4 %t/large.krn -o %t/parallel4.asm
+// RUN: %iga -p=xehpg -d -Xparallel-threads=3 %t/large.krn -o %t/parallel3.asm
+// RUN: diff %t/serial.asm %t/parallel4.asm
+// RUN: diff %t/serial.asm %t/parallel3.asm
+// RUN: FileCheck %s --input-file %t/parallel4.asm
+
+// CHECK: jmpi
+// CHECK: add (8|M0)
+// CHECK: mov (16|M0){{.*}}{Compacted}
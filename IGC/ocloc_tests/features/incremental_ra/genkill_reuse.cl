@@ -0,0 +1,41 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that gen/kill sets incremental RA reuses across GRF RA
+// iterations of a spilling kernel with loops and branches match the ones
+// recomputed with verification, and that both give the same binary. The
+// vISA options are passed through the environment so that both builds get
+// identical build options.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: env IGC_VISAOptions="-incrementalra 1" ocloc compile -file %s -device dg2 -out_dir %t -output inc -output_no_suffix
+// RUN: env IGC_VISAOptions="-incrementalra 2" ocloc compile -file %s -device dg2 -out_dir %t -output verify -output_no_suffix
+// RUN: cmp %t/inc.bin %t/verify.bin
+// RUN: ocloc compile -file %s -device dg2 -options " -igc_opts 'VISAOptions=-incrementalra 2 -asmToConsole'" | FileCheck %s
+// CHECK: .kernel spill
+// CHECK: //.spill size {{[1-9][0-9]*}}
+
+kernel void spill(global float4* buf, global const int* sel, int n) {
+  int gid = get_global_id(0);
+  float4 acc[64];
+  for (int i = 0; i < 64; ++i)
+    acc[i] = buf[gid * 64 + i];
+  for (int k = 0; k < n; ++k) {
+    if (sel[k] & 1) {
+      for (int i = 0; i < 64; ++i)
+        acc[i] = mad(acc[i], acc[(i + 1) % 64], acc[(i + 7) % 64]);
+    } else {
+      for (int i = 0; i < 64; ++i)
+        acc[i] = fma(acc[(i + 5) % 64], acc[i], acc[(i + 3) % 64]);
+    }
+  }
+  for (int i = 0; i < 64; ++i)
+    buf[gid * 64 + i] = acc[i];
+}
@@ -0,0 +1,31 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that inline vISA asm is compiled both when it is parsed
+// straight into the in-memory kernel and when the kernel is printed as vISA
+// text and parsed again. Several blocks go through the parser in one kernel.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -device dg2 -options " -igc_opts 'EnableInlineVISAAsmMerge=1,VISAOptions=-asmToConsole'" | FileCheck %s --check-prefix=CHECK-ASM
+// RUN: ocloc compile -file %s -device dg2 -options " -igc_opts 'EnableInlineVISAAsmMerge=0,VISAOptions=-asmToConsole'" | FileCheck %s --check-prefix=CHECK-ASM
+
+// CHECK-ASM: .kernel test_inline_asm
+// CHECK-ASM: add (16|M0) {{.*}}:d {{.*}}:d {{(0x)?}}7:{{[dw]}}
+// CHECK-ASM: or (16|M0) {{.*}}:d {{.*}}:d {{(0x)?}}3:{{[dw]}}
+
+__attribute__((intel_reqd_sub_group_size(16)))
+kernel void test_inline_asm(global int* buf) {
+  int gid = get_global_id(0);
+  int a = buf[gid];
+  int r;
+  int s;
+  __asm__ volatile("add (M1, 16) %0(0,0)<1> %1(0,0)<1;1,0> 0x7:d" : "=rw"(r) : "rw"(a));
+  __asm__ volatile("or (M1, 16) %0(0,0)<1> %1(0,0)<1;1,0> 0x3:d" : "=rw"(s) : "rw"(r));
+  buf[gid] = s;
+}
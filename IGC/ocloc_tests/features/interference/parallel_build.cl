@@ -0,0 +1,45 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that building the interference graph of a kernel with many
+// BBs on worker threads gives the same edges as the serial build, which
+// -verifyIntfBuild checks on every GRF RA iteration, and the same binary.
+// The vISA options are passed through the environment so that all builds get
+// identical build options.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: env IGC_VISAOptions="-intfBuildThreads 0" ocloc compile -file %s -device dg2 -out_dir %t -output serial -output_no_suffix
+// RUN: env IGC_VISAOptions="-intfBuildThreads 4 -verifyIntfBuild" ocloc compile -file %s -device dg2 -out_dir %t -output parallel -output_no_suffix 2> %t/verify.txt
+// RUN: FileCheck %s --input-file %t/verify.txt --allow-empty
+// RUN: cmp %t/serial.bin %t/parallel.bin
+
+// CHECK-NOT: Parallel interference of
+
+kernel void branches(global float4* buf, global const int* ops, int n) {
+  int gid = get_global_id(0);
+  float4 a = buf[gid];
+  float4 b = buf[gid + 1];
+  float4 c = buf[gid + 2];
+  for (int i = 0; i < n; ++i) {
+    switch (ops[i] & 7) {
+    case 0: a = mad(a, b, c); break;
+    case 1: b = a * native_sqrt(fabs(c)); break;
+    case 2: c = native_exp(a - b); break;
+    case 3: a = select(b, c, isgreater(a, b)); break;
+    case 4: b = fmax(a, c) - fmin(b, c); break;
+    case 5: c = native_sin(a) + native_cos(b); break;
+    case 6: a = a.wzyx + c; break;
+    default: b = b * 0.5f + c; break;
+    }
+    if (a.x > 100.0f)
+      a = 0.0f;
+  }
+  buf[gid] = a + b + c;
+}
@@ -0,0 +1,39 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that the on-disk kernel cache stores a build, returns the
+// same binary for an identical build without storing it again, and stores a
+// separate entry when an option changes.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t/cache
+
+// First build is a miss and stores one entry.
+// RUN: env IGC_EnableKernelCache=1 IGC_KernelCacheDir=%t/cache ocloc compile -file %s -device dg2 -out_dir %t -output first -output_no_suffix
+// RUN: ls %t/cache | grep -c llvmcache- | FileCheck %s --check-prefix=ONE
+// RUN: ls -i %t/cache | grep llvmcache- > %t/entry_first
+
+// Identical build is a hit: same binary, entry not rewritten.
+// RUN: env IGC_EnableKernelCache=1 IGC_KernelCacheDir=%t/cache ocloc compile -file %s -device dg2 -out_dir %t -output second -output_no_suffix
+// RUN: cmp %t/first.bin %t/second.bin
+// RUN: ls -i %t/cache | grep llvmcache- > %t/entry_second
+// RUN: cmp %t/entry_first %t/entry_second
+
+// A different option is a miss and stores a second entry.
+// RUN: env IGC_EnableKernelCache=1 IGC_KernelCacheDir=%t/cache ocloc compile -file %s -device dg2 -options "-cl-fast-relaxed-math" -out_dir %t -output relaxed -output_no_suffix
+// RUN: ls %t/cache | grep -c llvmcache- | FileCheck %s --check-prefix=TWO
+
+// ONE: {{^}}1{{$}}
+// TWO: {{^}}2{{$}}
+
+kernel void blend(global const float* a, global const float* b,
+                  global float* out, float t) {
+  int gid = get_global_id(0);
+  out[gid] = a[gid] * (1.0f - t) + b[gid] * native_sqrt(t);
+}
@@ -0,0 +1,46 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that the worklist liveness solver reaches the same live-in
+// sets as sweeping all BBs until nothing changes, on a kernel with nested
+// loops and early exits whose sets need several passes to converge.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: ocloc compile -file %s -device dg2 -options " -igc_opts 'VISAOptions=-dumpLiveness'" -out_dir %t -output worklist -output_no_suffix 2> %t/worklist.txt
+// RUN: ocloc compile -file %s -device dg2 -options " -igc_opts 'VISAOptions=-dumpLiveness -livenessFullSweep'" -out_dir %t -output sweep -output_no_suffix 2> %t/sweep.txt
+// RUN: FileCheck %s --input-file %t/worklist.txt
+// RUN: cmp %t/worklist.txt %t/sweep.txt
+
+// CHECK: live in:
+
+kernel void nest(global float* buf, global const int* bounds, int n, int m) {
+  int gid = get_global_id(0);
+  float acc = buf[gid];
+  float carry = 0.0f;
+  for (int i = 0; i < n; ++i) {
+    float row = buf[gid + i];
+    for (int j = 0; j < m; ++j) {
+      if (bounds[j] < i)
+        break;
+      for (int k = 0; k < j; ++k) {
+        carry = mad(carry, row, (float)k);
+        if (carry > 1000.0f) {
+          carry = 0.0f;
+          continue;
+        }
+        acc += carry * row;
+      }
+      row = native_sin(row + acc);
+    }
+    if (acc < 0.0f)
+      break;
+  }
+  buf[gid] = acc + carry;
+}
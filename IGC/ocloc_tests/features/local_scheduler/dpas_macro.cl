@@ -0,0 +1,35 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that the post-RA local scheduler handles blocks where
+// back-to-back DPAS instructions are grouped into one dependence graph node,
+// which leaves holes in the node IDs. All DPAS must survive scheduling.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole'" -device dg2 | FileCheck %s --check-prefix=CHECK-ASM
+// CHECK-ASM: .kernel gemm
+// CHECK-ASM-COUNT-4: dpas.8x8 (8|M0)
+
+__attribute__((intel_reqd_sub_group_size(8)))
+kernel void gemm(global const short8* a, global const int8* b, global int8* c) {
+  int gid = get_global_id(0);
+  int8 acc0 = c[gid * 4 + 0];
+  int8 acc1 = c[gid * 4 + 1];
+  int8 acc2 = c[gid * 4 + 2];
+  int8 acc3 = c[gid * 4 + 3];
+  int8 bv = b[gid];
+  acc0 = intel_sub_group_i8_i8_matrix_mad_k32(a[gid * 4 + 0], bv, acc0);
+  acc1 = intel_sub_group_i8_i8_matrix_mad_k32(a[gid * 4 + 1], bv, acc1);
+  acc2 = intel_sub_group_i8_i8_matrix_mad_k32(a[gid * 4 + 2], bv, acc2);
+  acc3 = intel_sub_group_i8_i8_matrix_mad_k32(a[gid * 4 + 3], bv, acc3);
+  c[gid * 4 + 0] = acc0 + acc1;
+  c[gid * 4 + 1] = acc1 + acc2;
+  c[gid * 4 + 2] = acc2 + acc3;
+  c[gid * 4 + 3] = acc3 + acc0;
+}
@@ -0,0 +1,54 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that scheduling the blocks of a kernel for pressure and
+// latency before RA on worker threads gives the same binary as scheduling
+// them serially. Every block has several loads, so latency scheduling runs on
+// blocks both before and after the first one that is changed.
+// The vISA options are passed through the environment so that all builds get
+// identical build options.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: env IGC_VISAOptions="-presched-threads 0" ocloc compile -file %s -device dg2 -out_dir %t -output serial -output_no_suffix
+// RUN: env IGC_VISAOptions="-presched-threads 4" ocloc compile -file %s -device dg2 -out_dir %t -output parallel -output_no_suffix
+// RUN: cmp %t/serial.bin %t/parallel.bin
+
+kernel void blocks(global float4* out, global const float4* in,
+                   global const int* idx, int n) {
+  int gid = get_global_id(0);
+  float4 acc = 0.0f;
+  if (n > 0) {
+    float4 a = in[idx[gid]];
+    float4 b = in[idx[gid + 1]];
+    float4 c = in[idx[gid + 2]];
+    acc += a * b + c;
+  }
+  if (n > 1) {
+    float4 a = in[idx[gid + 3]];
+    float4 b = in[idx[gid + 4]];
+    float4 c = in[idx[gid + 5]];
+    float4 d = in[idx[gid + 6]];
+    acc = mad(acc, a, b) + native_sqrt(fabs(c * d));
+  }
+  if (n > 2) {
+    float4 a = in[idx[gid + 7]];
+    float4 b = in[idx[gid + 8]];
+    float4 c = in[idx[gid + 9]];
+    acc = fmax(acc, a) * native_exp(b - c);
+  }
+  if (n > 3) {
+    float4 a = in[idx[gid + 10]];
+    float4 b = in[idx[gid + 11]];
+    float4 c = in[idx[gid + 12]];
+    float4 d = in[idx[gid + 13]];
+    acc = select(acc, a + b, isgreater(c, d));
+  }
+  out[gid] = acc;
+}
@@ -0,0 +1,43 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that compiling the kernels of a program on worker threads
+// produces the same binary as compiling the program as a whole. The regkeys
+// are passed through the environment so that both builds get identical options.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: env IGC_EnableParallelKernelCompile=0 ocloc compile -file %s -device dg2 -out_dir %t -output whole -output_no_suffix
+// RUN: env IGC_EnableParallelKernelCompile=1 IGC_ParallelKernelCompileThreads=2 ocloc compile -file %s -device dg2 -out_dir %t -output per_kernel -output_no_suffix
+// RUN: cmp %t/whole.bin %t/per_kernel.bin
+
+static float helper(float x, float y) {
+  return x > y ? sqrt(x - y) : native_exp(y - x);
+}
+
+kernel void scale(global float* buf, float factor) {
+  int gid = get_global_id(0);
+  buf[gid] = helper(buf[gid], factor) * factor;
+}
+
+kernel void saxpy(global const float* x, global float* y, float a) {
+  int gid = get_global_id(0);
+  y[gid] = mad(a, x[gid], helper(y[gid], a));
+}
+
+kernel void histogram(global const uchar* in, volatile global int* bins, volatile local int* tmp) {
+  int lid = get_local_id(0);
+  if (lid < 256)
+    tmp[lid] = 0;
+  barrier(CLK_LOCAL_MEM_FENCE);
+  atomic_inc(&tmp[in[get_global_id(0)]]);
+  barrier(CLK_LOCAL_MEM_FENCE);
+  if (lid < 256)
+    atomic_add(&bins[lid], tmp[lid]);
+}
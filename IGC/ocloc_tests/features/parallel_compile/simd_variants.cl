@@ -0,0 +1,76 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that compiling the SIMD variants of a kernel on worker
+// threads selects and emits the same binary as the serial flow, both when a
+// narrower variant is skipped because a wider one compiled and when the wider
+// one spills and the narrower one is needed. The regkeys are passed through
+// the environment so that all builds get identical options.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: env IGC_EnableParallelSIMDVariantCompile=0 ocloc compile -file %s -device dg2 -out_dir %t -output serial -output_no_suffix
+// RUN: env IGC_EnableParallelSIMDVariantCompile=1 IGC_ParallelSIMDVariantCompileThreads=3 ocloc compile -file %s -device dg2 -out_dir %t -output parallel -output_no_suffix
+// RUN: env IGC_EnableParallelSIMDVariantCompile=1 IGC_ParallelSIMDVariantCompileThreads=1 ocloc compile -file %s -device dg2 -out_dir %t -output parallel1 -output_no_suffix
+// RUN: cmp %t/serial.bin %t/parallel.bin
+// RUN: cmp %t/serial.bin %t/parallel1.bin
+
+kernel void small(global int* buf) {
+  int gid = get_global_id(0);
+  buf[gid] = buf[gid] * 3 + 1;
+}
+
+kernel void reduce(global const float* in, global float* out, local float* tmp) {
+  int lid = get_local_id(0);
+  tmp[lid] = in[get_global_id(0)];
+  barrier(CLK_LOCAL_MEM_FENCE);
+  for (int s = get_local_size(0) / 2; s > 0; s >>= 1) {
+    if (lid < s)
+      tmp[lid] += tmp[lid + s];
+    barrier(CLK_LOCAL_MEM_FENCE);
+  }
+  if (lid == 0)
+    out[get_group_id(0)] = tmp[0];
+}
+
+kernel void pressure(global float4* buf, int n) {
+  int gid = get_global_id(0);
+  float4 acc[8];
+  for (int i = 0; i < 8; ++i)
+    acc[i] = buf[gid * 8 + i];
+  for (int k = 0; k < n; ++k)
+    for (int i = 0; i < 8; ++i)
+      acc[i] = mad(acc[i], acc[(i + 1) % 8], acc[(i + 3) % 8]);
+  for (int i = 0; i < 8; ++i)
+    buf[gid * 8 + i] = acc[i];
+}
+
+kernel void spill(global float4* buf, int n) {
+  int gid = get_global_id(0);
+  float4 acc[48];
+  for (int i = 0; i < 48; ++i)
+    acc[i] = buf[gid * 48 + i];
+  for (int k = 0; k < n; ++k)
+    for (int i = 0; i < 48; ++i)
+      acc[i] = mad(acc[i], acc[(i + 7) % 48], acc[(i + 13) % 48]);
+  for (int i = 0; i < 48; ++i)
+    buf[gid * 48 + i] = acc[i];
+}
+
+__attribute__((intel_reqd_sub_group_size(8)))
+kernel void forced8(global int* buf) {
+  int gid = get_global_id(0);
+  buf[gid] = sub_group_reduce_add(buf[gid]);
+}
+
+__attribute__((intel_reqd_sub_group_size(32)))
+kernel void forced32(global int* buf) {
+  int gid = get_global_id(0);
+  buf[gid] = sub_group_reduce_add(buf[gid]);
+}
@@ -0,0 +1,44 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// The test checks that computing the SWSB operand footprints on worker
+// threads gives the same binary as computing them during the serial
+// dependence analysis, for a kernel with sends and branches over many BBs.
+// The vISA options are passed through the environment so that both builds
+// get identical build options.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: env IGC_VISAOptions="-SWSBThreads 0" ocloc compile -file %s -device dg2 -out_dir %t -output serial -output_no_suffix
+// RUN: env IGC_VISAOptions="-SWSBThreads 4" ocloc compile -file %s -device dg2 -out_dir %t -output parallel -output_no_suffix
+// RUN: cmp %t/serial.bin %t/parallel.bin
+
+kernel void gather(global const float4* in, global const int* idx,
+                   global float4* out, local float4* tmp, int n) {
+  int gid = get_global_id(0);
+  int lid = get_local_id(0);
+  float4 acc = 0.0f;
+  for (int k = 0; k < n; ++k) {
+    int i = idx[gid * n + k];
+    if (i < 0)
+      continue;
+    float4 v = in[i];
+    if (v.x > v.y)
+      acc += v * v.w;
+    else
+      acc = mad(acc, v, in[i + 1]);
+    if ((k & 7) == 0) {
+      tmp[lid] = acc;
+      barrier(CLK_LOCAL_MEM_FENCE);
+      acc += tmp[(lid + 1) % get_local_size(0)];
+      barrier(CLK_LOCAL_MEM_FENCE);
+    }
+  }
+  out[gid] = acc;
+}
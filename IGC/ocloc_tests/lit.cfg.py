@@ -51,6 +51,10 @@ if config.spirv_as_enabled:
   config.available_features.add('spirv-as')
   llvm_config.add_tool_substitutions([ToolSubst('spirv-as', unresolved='fatal')], tool_dirs)
 
+if config.iga_exe:
+  config.available_features.add('iga')
+  config.substitutions.append(('%iga', config.iga_exe))
+
 if config.use_khronos_spirv_translator_in_sc == "1":
   config.available_features.add('khronos-translator')
   config.available_features.add('khronos-translator-' + config.llvm_version_major)
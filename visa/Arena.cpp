@@ -40,15 +40,83 @@ void *ArenaHeader::AllocSpace(size_t size, size_t al) {
   return allocSpace;
 }
 
+void ArenaManager::FreeArenaList(ArenaHeader *arena) {
+  while (arena) {
+    unsigned char *killed = (unsigned char *)arena;
+    arena = arena->_nextArena;
+    delete[] killed;
+  }
+}
+
+struct ArenaManager::ReleasedArenas {
+  ArenaHeader *arenas = nullptr;
+  size_t bytes = 0;
+
+  ~ReleasedArenas();
+};
+
+// Managers may be destroyed on a thread after its released arenas are
+static thread_local bool releasedArenasDestroyed = false;
+
+ArenaManager::ReleasedArenas::~ReleasedArenas() {
+  FreeArenaList(arenas);
+  arenas = nullptr;
+  releasedArenasDestroyed = true;
+}
+
+ArenaManager::ReleasedArenas &ArenaManager::GetReleasedArenas() {
+  static thread_local ReleasedArenas released;
+  return released;
+}
+
+ArenaHeader *ArenaManager::ReuseArena(size_t dataSize) {
+  if (releasedArenasDestroyed)
+    return nullptr;
+
+  ReleasedArenas &releasedArenas = GetReleasedArenas();
+
+  // Arenas are released in no particular order, take the first one that fits
+  for (ArenaHeader **prev = &releasedArenas.arenas; *prev;
+       prev = &(*prev)->_nextArena) {
+    ArenaHeader *arena = *prev;
+    if (arena->size >= dataSize) {
+      *prev = arena->_nextArena;
+      arena->_nextArena = nullptr;
+      arena->Rewind();
+      releasedArenas.bytes -= arena->size;
+      return arena;
+    }
+  }
+  return nullptr;
+}
+
+void ArenaManager::ReleaseArenaList(ArenaHeader *arena) {
+  if (releasedArenasDestroyed) {
+    FreeArenaList(arena);
+    return;
+  }
+
+  ReleasedArenas &releasedArenas = GetReleasedArenas();
+  while (arena) {
+    ArenaHeader *next = arena->_nextArena;
+    if (releasedArenas.bytes + arena->size > maxReleasedBytes) {
+      delete[] (unsigned char *)arena;
+    } else {
+      arena->_nextArena = releasedArenas.arenas;
+      releasedArenas.arenas = arena;
+      releasedArenas.bytes += arena->size;
+    }
+    arena = next;
+  }
+}
+
 void ArenaManager::FreeArenas() {
-  while (_arenas) {
 #ifdef COLLECT_ALLOCATION_STATS
-    currentMallocSize -= _arenas->size;
+  currentMallocSize -= _stats.arenaBytes;
 #endif
-    unsigned char *killed = (unsigned char *)_arenas;
-    _arenas = _arenas->_nextArena;
-    delete[] killed;
-  }
+  ReleaseArenaList(_arenas);
 
   _arenas = 0;
+  _stats.numArenas = 0;
+  _stats.arenaBytes = 0;
 }
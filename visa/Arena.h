@@ -85,6 +85,9 @@ private:
 
   void *AllocSpace(size_t size, size_t align);
 
+  // Makes the whole arena available again.
+  void Rewind() { _nextByte = GetArenaData(); }
+
   // Data
 
   ArenaHeader *_nextArena;  // Word aligned
@@ -93,6 +96,31 @@ private:
   size_t size;
 };
 
+// Allocation statistics of an arena manager. These are always collected as
+// they cost a couple of additions per allocation.
+struct ArenaStats {
+  size_t numAllocations = 0;
+  // Bytes requested by the allocations
+  size_t allocatedBytes = 0;
+  // Arenas currently owned
+  size_t numArenas = 0;
+  size_t arenaBytes = 0;
+  // Number of times an arena had to be malloc'ed
+  size_t numMallocs = 0;
+  // Number of arenas taken from the arenas released on the same thread
+  size_t numReused = 0;
+
+  ArenaStats &operator+=(const ArenaStats &other) {
+    numAllocations += other.numAllocations;
+    allocatedBytes += other.allocatedBytes;
+    numArenas += other.numArenas;
+    arenaBytes += other.arenaBytes;
+    numMallocs += other.numMallocs;
+    numReused += other.numReused;
+    return *this;
+  }
+};
+
 class ArenaManager {
   friend class Mem_Manager;
 
@@ -100,7 +128,8 @@ private:
   // Functions
 
   ArenaManager(size_t defaultArenaSize)
-      : _arenas(0), _defaultArenaSize(defaultArenaSize) {
+      : _arenas(0), _defaultArenaSize(defaultArenaSize),
+        _nextArenaSize(defaultArenaSize) {
     CreateArena(_defaultArenaSize);
   }
 
@@ -129,51 +158,77 @@ private:
     numAllocations++;
     totalAllocSize += size;
 #endif
+    _stats.numAllocations++;
+    _stats.allocatedBytes += size;
 
     return space;
   }
 
   ArenaHeader *CreateArena(size_t size) {
     size_t arenaDataSize =
-        (size > _defaultArenaSize) ? size : _defaultArenaSize;
+        (size > _nextArenaSize) ? size : _nextArenaSize;
     arenaDataSize = ArenaHeader::DefaultAlign(arenaDataSize);
-    unsigned char *arena =
-        new unsigned char[ArenaHeader::GetArenaSize(arenaDataSize)];
 
-    ArenaHeader *newArena = new (arena) ArenaHeader(arenaDataSize, _arenas);
-    // Add new arena to the head of queue
-    if (_arenas != NULL) {
-      newArena->_nextArena = _arenas;
+    ArenaHeader *newArena = ReuseArena(arenaDataSize);
+    if (newArena) {
+      _stats.numReused++;
+    } else {
+      unsigned char *arena =
+          new unsigned char[ArenaHeader::GetArenaSize(arenaDataSize)];
+      newArena = new (arena) ArenaHeader(arenaDataSize, _arenas);
+      _stats.numMallocs++;
     }
+    _stats.numArenas++;
+    _stats.arenaBytes += newArena->size;
 
-    _arenas = newArena;
+    // Grow geometrically so that managers holding a lot of data need few
+    // arenas without making small managers waste memory.
+    if (_nextArenaSize < maxArenaSize) {
+      _nextArenaSize *= 2;
+    }
 
 #ifdef COLLECT_ALLOCATION_STATS
     numMallocCalls++;
     totalMallocSize += arenaDataSize;
     currentMallocSize += arenaDataSize;
-    int numArenas = 0;
-    for (ArenaHeader *tmpArena = _arenas; tmpArena != NULL;
-         tmpArena = tmpArena->_nextArena) {
-      numArenas++;
+    if ((int)_stats.numArenas > maxArenaLength) {
+      maxArenaLength = _stats.numArenas;
     }
-    if (numArenas > maxArenaLength) {
-      maxArenaLength = numArenas;
-    }
-    if (numArenas == 1) {
+    if (_stats.numArenas == 1) {
       numMemManagers++;
     }
 #endif
 
+    // Add new arena to the head of queue
+    newArena->_nextArena = _arenas;
+    _arenas = newArena;
+
     return _arenas;
   }
 
   void FreeArenas();
+  static void FreeArenaList(ArenaHeader *arena);
+
+  // Arenas of the managers destroyed on a thread are kept, up to
+  // maxReleasedBytes, for the managers created next on it. A compile thread
+  // thus reuses the arenas of the previous kernel instead of malloc'ing new
+  // ones.
+  struct ReleasedArenas;
+  static ReleasedArenas &GetReleasedArenas();
+  static ArenaHeader *ReuseArena(size_t dataSize);
+  static void ReleaseArenaList(ArenaHeader *arena);
 
   // Data
 
   ArenaHeader *_arenas;
   const size_t _defaultArenaSize;
+  size_t _nextArenaSize;
+  ArenaStats _stats;
+
+  // Arenas stop growing at this size, larger allocations still get an arena
+  // of their own size.
+  static const size_t maxArenaSize = 1024 * 1024;
+  static const size_t maxReleasedBytes = 16 * maxArenaSize;
 };
 } // namespace vISA
 #endif
@@ -10,13 +10,17 @@ SPDX-License-Identifier: MIT
 #define _BITSET_H_
 
 #include "Mem_Manager.h"
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <map>
+#include <vector>
 
 // clang-format off
 #include "common/LLVMWarningsPush.hpp"
 #include "llvm/ADT/SparseBitVector.h"
+#include "llvm/Support/MathExtras.h"
 #include "common/LLVMWarningsPop.hpp"
 // clang-format on
 
@@ -198,11 +202,7 @@ public:
     unsigned arraySize = (m_Size + NUM_BITS_PER_ELT - 1) / NUM_BITS_PER_ELT;
 
     for (unsigned i = 0; i < arraySize; i++) {
-      BITSET_ARRAY_TYPE value = m_BitSetArray[i];
-      while (value) {
-        ++count;
-        value = value & (value - 1);
-      }
+      count += llvm::countPopulation(m_BitSetArray[i]);
     }
     return count;
   }
@@ -896,4 +896,218 @@ public:
   }
 };
 
+// HybridBitSet is a set of unsigned integers for the rows of large, mostly
+// sparse matrices such as the RA interference graph. A row starts out as a
+// sorted array of its elements, which keeps low-degree rows small and cheap
+// to walk. Once the array would take more space than a bitmap covering the
+// same range of elements, the row switches to such a bitmap so that lookups
+// in high-degree rows are constant time. Elements are visited in increasing
+// order in both forms.
+class HybridBitSet {
+  // Either the sorted elements or the bitmap words, the first word covering
+  // elements [FirstWord * NUM_BITS_PER_ELT, (FirstWord + 1) * NUM_BITS_PER_ELT)
+  std::vector<BITSET_ARRAY_TYPE> Data;
+  unsigned FirstWord = 0;
+  unsigned NumElts = 0;
+  bool Dense = false;
+
+  // Rows this small stay arrays no matter how close their elements are.
+  static const unsigned MinDenseElts = 16;
+
+  void makeDenseIfSmaller() {
+    if (Dense || NumElts <= MinDenseElts)
+      return;
+    unsigned first = Data.front() / NUM_BITS_PER_ELT;
+    unsigned last = Data.back() / NUM_BITS_PER_ELT;
+    if (NumElts <= last - first + 1)
+      return;
+
+    std::vector<BITSET_ARRAY_TYPE> words(last - first + 1, 0);
+    for (unsigned elt : Data) {
+      words[elt / NUM_BITS_PER_ELT - first] |= _BIT(elt % NUM_BITS_PER_ELT);
+    }
+    Data.swap(words);
+    FirstWord = first;
+    Dense = true;
+  }
+
+  // Grows the bitmap so that it covers words [first, last].
+  void cover(unsigned first, unsigned last) {
+    if (Data.empty()) {
+      FirstWord = first;
+      Data.resize(last - first + 1, 0);
+      return;
+    }
+    if (first < FirstWord) {
+      Data.insert(Data.begin(), FirstWord - first, 0);
+      FirstWord = first;
+    }
+    if (last >= FirstWord + Data.size()) {
+      Data.resize(last - FirstWord + 1, 0);
+    }
+  }
+
+public:
+  class const_iterator {
+    const HybridBitSet *Set;
+    unsigned Idx;
+    // Elements of the current word not visited yet, for dense sets
+    BITSET_ARRAY_TYPE Bits = 0;
+
+    void skipEmptyWords() {
+      while (Bits == 0 && ++Idx < Set->Data.size()) {
+        Bits = Set->Data[Idx];
+      }
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = unsigned;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const unsigned *;
+    using reference = unsigned;
+
+    const_iterator(const HybridBitSet *set, bool end)
+        : Set(set), Idx(end ? (unsigned)set->Data.size() : 0) {
+      if (Set->Dense && Idx < Set->Data.size()) {
+        Bits = Set->Data[Idx];
+        skipEmptyWords();
+      }
+    }
+
+    unsigned operator*() const {
+      if (!Set->Dense)
+        return Set->Data[Idx];
+      return (Set->FirstWord + Idx) * NUM_BITS_PER_ELT +
+             llvm::countTrailingZeros(Bits);
+    }
+
+    const_iterator &operator++() {
+      if (!Set->Dense) {
+        ++Idx;
+      } else {
+        Bits &= Bits - 1;
+        skipEmptyWords();
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return Idx == other.Idx && Bits == other.Bits;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+  const_iterator begin() const { return const_iterator(this, false); }
+  const_iterator end() const { return const_iterator(this, true); }
+
+  bool empty() const { return NumElts == 0; }
+  unsigned count() const { return NumElts; }
+  bool isDense() const { return Dense; }
+
+  void clear() {
+    Data.clear();
+    FirstWord = 0;
+    NumElts = 0;
+    Dense = false;
+  }
+
+  bool test(unsigned elt) const {
+    if (!Dense)
+      return std::binary_search(Data.begin(), Data.end(), elt);
+    unsigned word = elt / NUM_BITS_PER_ELT;
+    if (word < FirstWord || word - FirstWord >= Data.size())
+      return false;
+    return Data[word - FirstWord] & _BIT(elt % NUM_BITS_PER_ELT);
+  }
+
+  void set(unsigned elt) {
+    if (!Dense) {
+      auto it = std::lower_bound(Data.begin(), Data.end(), elt);
+      if (it != Data.end() && *it == elt)
+        return;
+      Data.insert(it, elt);
+      ++NumElts;
+      makeDenseIfSmaller();
+      return;
+    }
+    unsigned word = elt / NUM_BITS_PER_ELT;
+    cover(word, word);
+    BITSET_ARRAY_TYPE &w = Data[word - FirstWord];
+    if (!(w & _BIT(elt % NUM_BITS_PER_ELT))) {
+      w |= _BIT(elt % NUM_BITS_PER_ELT);
+      ++NumElts;
+    }
+  }
+
+  void reset(unsigned elt) {
+    if (!Dense) {
+      auto it = std::lower_bound(Data.begin(), Data.end(), elt);
+      if (it != Data.end() && *it == elt) {
+        Data.erase(it);
+        --NumElts;
+      }
+      return;
+    }
+    unsigned word = elt / NUM_BITS_PER_ELT;
+    if (word < FirstWord || word - FirstWord >= Data.size())
+      return;
+    BITSET_ARRAY_TYPE &w = Data[word - FirstWord];
+    if (w & _BIT(elt % NUM_BITS_PER_ELT)) {
+      w &= ~_BIT(elt % NUM_BITS_PER_ELT);
+      --NumElts;
+    }
+  }
+
+  HybridBitSet &operator|=(const HybridBitSet &other) {
+    if (other.empty() || this == &other)
+      return *this;
+
+    if (!Dense && !other.Dense) {
+      std::vector<BITSET_ARRAY_TYPE> merged;
+      merged.reserve(Data.size() + other.Data.size());
+      std::set_union(Data.begin(), Data.end(), other.Data.begin(),
+                     other.Data.end(), std::back_inserter(merged));
+      Data.swap(merged);
+      NumElts = (unsigned)Data.size();
+      makeDenseIfSmaller();
+      return *this;
+    }
+
+    if (!other.Dense) {
+      for (unsigned elt : other.Data) {
+        set(elt);
+      }
+      return *this;
+    }
+
+    if (!Dense) {
+      HybridBitSet tmp(other);
+      tmp |= *this;
+      *this = std::move(tmp);
+      return *this;
+    }
+
+    cover(other.FirstWord,
+          other.FirstWord + (unsigned)other.Data.size() - 1);
+    NumElts = 0;
+    for (unsigned i = 0, e = (unsigned)Data.size(); i < e; ++i) {
+      unsigned otherIdx = FirstWord + i - other.FirstWord;
+      if (FirstWord + i >= other.FirstWord && otherIdx < other.Data.size()) {
+        Data[i] |= other.Data[otherIdx];
+      }
+      NumElts += llvm::countPopulation(Data[i]);
+    }
+    return *this;
+  }
+};
+
 #endif
@@ -20,6 +20,7 @@ SPDX-License-Identifier: MIT
 
 #include <cstdint>
 #include <sstream>
+#include <utility>
 
 namespace vISA {
 class Mem_Manager;
@@ -93,6 +94,8 @@ public:
   VISA_BUILDER_API int ParseVISAText(const std::string &visaText,
                                      const std::string &visaTextFile) override;
   VISA_BUILDER_API int ParseVISAText(const std::string &visaFile) override;
+  VISA_BUILDER_API int ParseVISAInlineAsm(VISAKernel *kernel,
+                                          const std::string &visaText) override;
   VISA_BUILDER_API std::stringstream &GetAsmTextStream() override {
     return m_ssIsaAsm;
   }
@@ -121,6 +124,9 @@ public:
 
   bool debugParse() const { return m_options.getOption(vISA_DebugParse); }
 
+  // Called by the lexer, returns true once at the start of inline asm parse
+  bool takeInlineAsmStart() { return std::exchange(m_inlineAsmStart, false); }
+
   int verifyVISAIR();
 
   int isaDump(const char *combinedIsaasmName) const;
@@ -669,6 +675,9 @@ private:
   // FIXME: we need to make 3D/media per kernel instead of per builder
   const vISABuilderMode m_builderMode;
 
+  // Set while the parser is yet to see the start of an inline asm block
+  bool m_inlineAsmStart = false;
+
   unsigned int m_kernel_count = 0;
   unsigned int m_function_count = 0;
 
@@ -689,6 +698,11 @@ private:
   const WA_TABLE *m_pWaTable;
   bool needsToFreeWATable = false;
 
+  // Start of the TOTAL and BUILDER timers on the thread that created the
+  // builder, so that Compile() on another thread can stop them.
+  int64_t m_totalTimerStart = 0;
+  int64_t m_builderTimerStart = 0;
+
   void *gtpin_init = nullptr;
 
   // important messages that we should relay to the user
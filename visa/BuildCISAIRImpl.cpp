@@ -242,6 +242,8 @@ int CISA_IR_Builder::CreateBuilder(CISA_IR_Builder *&builder,
   builder =
       new CISA_IR_Builder(platform, buildOption, mode, COMMON_ISA_MAJOR_VER,
                           COMMON_ISA_MINOR_VER, pWaTable);
+  builder->m_totalTimerStart = getTimerStart(TimerID::TOTAL);
+  builder->m_builderTimerStart = getTimerStart(TimerID::BUILDER);
 
   if (pWaTable) {
     AddWAOptions(builder->m_options, *pWaTable);
@@ -1473,6 +1475,7 @@ typedef struct yy_buffer_state *YY_BUFFER_STATE;
 extern int CISAparse(CISA_IR_Builder *builder);
 extern YY_BUFFER_STATE CISA_scan_string(const char *yy_str);
 extern void CISA_delete_buffer(YY_BUFFER_STATE buf);
+extern int CISAlineno;
 static std::mutex mtx;
 
 int CISA_IR_Builder::ParseVISAText(const std::string &visaText,
@@ -1496,6 +1499,14 @@ int CISA_IR_Builder::ParseVISAText(const std::string &visaText,
     }
   }
 
+  // Builders of in-memory kernels that inline asm is merged into only index
+  // variables by name while parsing, and keep building their current kernel
+  // afterwards.
+  bool wasParseMode = m_options.getOption(vISA_isParseMode);
+  m_options.setOptionInternally(vISA_isParseMode, true);
+  VISAKernelImpl *prevKernel = m_kernel;
+
+  CISAlineno = 1;
   YY_BUFFER_STATE visaBuf = CISA_scan_string(visaText.c_str());
   if (CISAparse(this) != 0) {
 #ifndef DLL_MODE
@@ -1508,6 +1519,10 @@ int CISA_IR_Builder::ParseVISAText(const std::string &visaText,
     status = VISA_FAILURE;
   }
   CISA_delete_buffer(visaBuf);
+  m_options.setOptionInternally(vISA_isParseMode, wasParseMode);
+  if (m_builderMode != vISA_ASM_READER) {
+    m_kernel = prevKernel;
+  }
 
   if (CISAout) {
     fclose(CISAout);
@@ -1550,9 +1565,53 @@ int CISA_IR_Builder::ParseVISAText(const std::string &visaFile) {
 
 }
 
+// Parses inline asm into kernel at its current position. Unlike
+// ParseVISAText(), the verifier is left to Compile() so that it runs once
+// for the whole kernel instead of once per inline asm block.
+int CISA_IR_Builder::ParseVISAInlineAsm(VISAKernel *kernel,
+                                        const std::string &visaText) {
+  const std::lock_guard<std::mutex> lock(mtx);
+  vISA_ASSERT(m_options.getOption(vISA_MergeInlineAsm),
+              "kernel doesn't index its variables by name");
+#if defined(_WIN32)
+  CISAout = fopen("nul", "w");
+#else
+  CISAout = fopen("/dev/null", "w");
+#endif
+
+  VISAKernelImpl *prevKernel = m_kernel;
+  m_kernel = static_cast<VISAKernelImpl *>(kernel);
+  bool wasParseMode = m_options.getOption(vISA_isParseMode);
+  m_options.setOptionInternally(vISA_isParseMode, true);
+  m_inlineAsmStart = true;
+
+  int status = VISA_SUCCESS;
+  CISAlineno = 1;
+  YY_BUFFER_STATE visaBuf = CISA_scan_string(visaText.c_str());
+  if (CISAparse(this) != 0) {
+#ifndef DLL_MODE
+    std::cerr << "Parsing inline visa asm failed.\n" << criticalMsg.str();
+#endif // DLL_MODE
+    status = VISA_FAILURE;
+  }
+  CISA_delete_buffer(visaBuf);
+
+  m_inlineAsmStart = false;
+  m_options.setOptionInternally(vISA_isParseMode, wasParseMode);
+  m_kernel = prevKernel;
+
+  if (CISAout) {
+    fclose(CISAout);
+  }
+  return status;
+}
+
 // default size of the kernel mem manager in bytes
 int CISA_IR_Builder::Compile(const char *isaasmFileName, bool emit_visa_only) {
-  // TIMER_BUILDER is started when builder is created
+  // TIMER_BUILDER is started when builder is created, possibly on another
+  // thread than the one compiling it.
+  resumeTimer(TimerID::TOTAL, m_totalTimerStart);
+  resumeTimer(TimerID::BUILDER, m_builderTimerStart);
   stopTimer(TimerID::BUILDER);
   int status = VISA_SUCCESS;
 
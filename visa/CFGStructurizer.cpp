@@ -401,12 +401,13 @@ public:
 
 #ifdef _DEBUG
 
+// The dump settings are per thread, as kernels may be compiled concurrently.
 // 0:  default, dumps only CF related instructions (CF instr, label)
 // 1:  All instructions
-static int dump_level = 0;
-static const char *currFileName = nullptr;
-static std::ofstream dump_ofs;
-static std::ostream *dumpOut = &std::cout; // default
+static thread_local int dump_level = 0;
+static thread_local const char *currFileName = nullptr;
+static thread_local std::ofstream dump_ofs;
+static thread_local std::ostream *dumpOut = &std::cout; // default
 
 // use this func or debugger to set dump_level
 void setDumpLevel(int l) { dump_level = l; }
@@ -283,7 +283,7 @@ std::vector<attr_gen_struct*> AttrOptVar;
     CISA_GEN_VAR*          vISADecl;
 } // end of possible token types
 
-%start Listing
+%start Input
 
 %type <intval> ScopeStart
 
@@ -303,6 +303,10 @@ std::vector<attr_gen_struct*> AttrOptVar;
 %token          DIRECTIVE_PARAMETER   // .parameter
 %token          DIRECTIVE_VERSION     // .verions
 
+// never matched in text, returned first when parsing inline asm into
+// an existing kernel
+%token          INLINE_ASM_START
+
 // tokens to support .decl and .input
 %token ALIAS_EQ             // .decl ... alias=...
 %token ALIGN_EQ             // .decl ... align=...
@@ -656,6 +660,8 @@ std::vector<attr_gen_struct*> AttrOptVar;
 
 
 %%
+Input: Listing | InlineAsm
+
 Listing: NewlinesOpt ListingHeader NewlinesOpt Statements NewlinesOpt {
         TRACE("** Listing Complete\n");
         pBuilder->CISA_post_file_parse();
@@ -663,6 +669,12 @@ Listing: NewlinesOpt ListingHeader NewlinesOpt Statements NewlinesOpt {
 
 ListingHeader: DirectiveVersion
 
+// Statements appended to the current kernel, see
+// CISA_IR_Builder::ParseVISAInlineAsm()
+InlineAsm:
+      INLINE_ASM_START NewlinesOpt
+    | INLINE_ASM_START NewlinesOpt Statements NewlinesOpt
+
 Statements: Statements Newlines Statement | Statement
 
 Newlines: Newlines NEWLINE | NEWLINE
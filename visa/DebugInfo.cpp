@@ -1968,13 +1968,11 @@ bool KernelDebugInfo::isFcallWithSaveRestore(G4_BB *bb) {
 
 // Compute extra instructions in insts over oldInsts list and
 // return a new list.
-INST_LIST KernelDebugInfo::getDeltaInstructions(G4_BB *bb) {
-  INST_LIST deltaInsts;
-  for (auto instIt = bb->begin(); instIt != bb->end(); instIt++)
-    deltaInsts.push_back(*instIt);
-
-  for (auto oldInstsIt : oldInsts) {
-    deltaInsts.remove(oldInstsIt);
+std::vector<G4_INST *> KernelDebugInfo::getDeltaInstructions(G4_BB *bb) {
+  std::vector<G4_INST *> deltaInsts;
+  for (auto inst : *bb) {
+    if (!oldInsts.count(inst))
+      deltaInsts.push_back(inst);
   }
 
   return deltaInsts;
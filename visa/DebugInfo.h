@@ -22,6 +22,7 @@ SPDX-License-Identifier: MIT
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace vISA {
@@ -218,7 +219,7 @@ private:
   std::unordered_map<G4_BB *, SaveRestore> callerSaveRestore;
   SaveRestore calleeSaveRestore;
 
-  INST_LIST oldInsts;
+  std::unordered_set<G4_INST *> oldInsts;
 
   // Store pair of cisa byte offset and gen byte offset in vector
   std::vector<IDX_VDbgCisaByte2Gen> mapCISAOffsetGenOffset;
@@ -315,9 +316,12 @@ public:
   std::vector<G4_INST *> &getCalleeSaveInsts();
   std::vector<G4_INST *> &getCalleeRestoreInsts();
 
-  void setOldInstList(G4_BB *bb) { oldInsts.assign(bb->begin(), bb->end()); }
+  void setOldInstList(G4_BB *bb) {
+    oldInsts.clear();
+    oldInsts.insert(bb->begin(), bb->end());
+  }
   void clearOldInstList() { oldInsts.clear(); }
-  INST_LIST getDeltaInstructions(G4_BB *bb);
+  std::vector<G4_INST *> getDeltaInstructions(G4_BB *bb);
 
   void resetRelocOffset() { reloc_offset = 0; }
   void updateMapping(std::list<G4_BB *> &stackCallEntryBBs);
@@ -22,6 +22,7 @@ SPDX-License-Identifier: MIT
 #include "iga/IGALibrary/api/iga.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
@@ -354,7 +355,8 @@ G4_BB *FlowGraph::createNewBBWithLabel(const char *LabelSuffix) {
   return newBB;
 }
 
-static int globalCount = 1;
+// Shared by the kernels that are compiled concurrently
+static std::atomic<int> globalCount{1};
 
 int64_t FlowGraph::insertDummyUUIDMov() {
   // Here when -addKernelId is passed
@@ -372,8 +374,7 @@ int64_t FlowGraph::insertDummyUUIDMov() {
       uint32_t seed = (uint32_t)std::chrono::high_resolution_clock::now()
                           .time_since_epoch()
                           .count();
-      std::mt19937 mt_rand(seed * globalCount);
-      globalCount++;
+      std::mt19937 mt_rand(seed * globalCount++);
 
       G4_DstRegRegion *nullDst = builder->createNullDst(Type_UD);
       int64_t uuID = (int64_t)mt_rand();
@@ -3547,7 +3548,7 @@ void FlowGraph::addSaveRestorePseudoDeclares(IR_Builder &builder) {
   // VCA_SAVE (r1.0-r60.0) [r0 is reserved] - one required per stack call,
   // but will be reused across cuts.
   //
-  INST_LIST callSites;
+  std::vector<G4_INST *> callSites;
   for (auto bb : builder.kernel.fg) {
     if (bb->isEndWithFCall()) {
       callSites.push_back(bb->back());
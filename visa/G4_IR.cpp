@@ -1116,7 +1116,7 @@ void G4_INST::swapDefUse(Gen4_Operand_Number srcIxA,
                          Gen4_Operand_Number srcIxB) {
   DEF_EDGE_LIST_ITER iter = defInstList.begin();
   // To avoid redundant define and use items
-  INST_LIST handledDefInst;
+  std::vector<G4_INST *> handledDefInst;
 
   // since ACC is only exposed in ARCTAN intrinsic translation, there is no
   // instruction split with ACC
@@ -64,6 +64,10 @@ vISA::G4_Declare *GetTopDclFromRegRegion(vISA::G4_Operand *opnd);
 typedef vISA::std_arena_based_allocator<vISA::G4_INST *>
     INST_LIST_NODE_ALLOCATOR;
 
+// An instruction is linked into at most one INST_LIST at a time: its BB, the
+// builder's list of new instructions, or a pass's saved copy of a BB that it
+// splices back. Containers of instructions that stay in their BB should be
+// plain vectors or sets. G4Verifier checks this across BBs.
 typedef std::list<vISA::G4_INST *, INST_LIST_NODE_ALLOCATOR> INST_LIST;
 typedef std::list<vISA::G4_INST *, INST_LIST_NODE_ALLOCATOR>::iterator
     INST_LIST_ITER;
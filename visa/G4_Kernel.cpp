@@ -18,6 +18,7 @@ SPDX-License-Identifier: MIT
 #include "iga/IGALibrary/api/kv.hpp"
 #include "visa_wa.h"
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <iomanip>
@@ -1076,6 +1077,33 @@ std::vector<ArgLayout> G4_Kernel::getArgumentLayout() {
   return args;
 }
 
+// A kernel switches to cheaper strategies when it is large enough to be
+// expected to use up its budget, see CompileTimeBudget. The effort only
+// depends on the kernel as it is when first asked, so that the same input
+// always gets the same code.
+G4_Kernel::CompileEffort G4_Kernel::getCompileEffort() {
+  if (compileEffort)
+    return *compileEffort;
+
+  compileEffort = CompileEffort::Full;
+  unsigned budgetMs = getuInt32Option(vISA_CompileTimeBudget);
+  if (budgetMs == 0)
+    return *compileEffort;
+
+  size_t size = Declares.size() + fg.size();
+  for (auto bb : fg)
+    size += bb->size();
+  double usage = size / ((double)CompileTimeBudget::SizePerMs * budgetMs);
+
+  if (usage >= CompileTimeBudget::FailSafeRAShare)
+    compileEffort = CompileEffort::FailSafeRA;
+  else if (usage >= CompileTimeBudget::FastRAShare)
+    compileEffort = CompileEffort::FastRA;
+  else if (usage >= CompileTimeBudget::NoScheduleShare)
+    compileEffort = CompileEffort::NoPreRASchedule;
+  return *compileEffort;
+}
+
 void G4_Kernel::dump(std::ostream &os) const { fg.print(os); }
 
 void G4_Kernel::dumpToFile(const std::string &suffixIn, bool forceG4Dump) {
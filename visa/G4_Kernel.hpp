@@ -19,6 +19,7 @@ SPDX-License-Identifier: MIT
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <optional>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
@@ -519,7 +520,6 @@ private:
     return gtPinInfo;
   }
 
-
 public:
   FlowGraph fg;
   DECLARE_LIST Declares;
@@ -635,6 +635,17 @@ public:
   void setName(const char *n) { name = n; }
   const char *getName() const { return name; }
 
+  // Optimization effort the kernel can afford under -compileTimeBudget, in
+  // the order the cheaper strategies kick in.
+  enum class CompileEffort { Full, NoPreRASchedule, FastRA, FailSafeRA };
+  CompileEffort getCompileEffort();
+
+private:
+  // Set by the first getCompileEffort() call.
+  std::optional<CompileEffort> compileEffort;
+
+public:
+
   bool updateKernelToLargerGRF();
   bool updateKernelToSmallerGRF();
   void updateKernelByRegPressure(unsigned regPressure);
@@ -9,6 +9,7 @@ SPDX-License-Identifier: MIT
 #include "G4_Verifier.hpp"
 
 #include <sstream>
+#include <unordered_set>
 
 using namespace vISA;
 
@@ -47,6 +48,8 @@ G4Verifier::G4Verifier(G4_Kernel &k, VerifyControl ctrl,
 }
 
 void G4Verifier::verify() {
+  // Each instruction must be in one BB only, see INST_LIST.
+  std::unordered_set<G4_INST *> seenInsts;
   // For each instruction do verification.
   for (auto BBI = kernel.fg.cbegin(), BBE = kernel.fg.cend(); BBI != BBE;
        ++BBI) {
@@ -59,6 +62,9 @@ void G4Verifier::verify() {
 
     for (auto I = bb->begin(), E = bb->end(); I != E; ++I) {
       G4_INST *inst = *I;
+      bool isNew = seenInsts.insert(inst).second;
+      vISA_ASSERT(isNew, "instruction is in more than one instruction list");
+      (void)isNew;
       verifyInst(inst);
     }
   }
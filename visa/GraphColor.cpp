@@ -14,6 +14,7 @@ SPDX-License-Identifier: MIT
 #include "LinearScanRA.h"
 #include "LocalRA.h"
 #include "Optimizer.h"
+#include "ParallelFor.h"
 #include "PointsToAnalysis.h"
 #include "RADebug.h"
 #include "RPE.h"
@@ -29,6 +30,7 @@ SPDX-License-Identifier: MIT
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <memory>
 #include <sstream>
 
 #include "common/LLVMWarningsPush.hpp"
@@ -68,6 +70,19 @@ Interference::Interference(const LivenessAnalysis *l, GlobalRA &g)
   incRA.registerNextIter((G4_RegFileKind)l->getSelectedRF(), l, this);
 }
 
+Interference::Interference(const Interference &intf,
+                           InterferenceMatrixStorage &storage)
+    : gra(intf.gra), kernel(intf.kernel), lrs(intf.lrs),
+      builder(intf.builder), maxId(intf.maxId), rowSize(intf.rowSize),
+      splitStartId(intf.splitStartId), splitNum(intf.splitNum),
+      liveAnalysis(intf.liveAnalysis), aug(*this, *intf.liveAnalysis, intf.gra),
+      incRA(intf.incRA), sparseIntf(storage.sparseIntf),
+      sparseMatrix(storage.sparseMatrix) {
+  // A worker only sees the edges of its own BBs, so sparse rows stay small
+  // where a dense matrix would cost as much as the whole graph per worker.
+  init();
+}
+
 criticalCmpForEndInterval::criticalCmpForEndInterval(GlobalRA &g) : gra(g) {}
 bool criticalCmpForEndInterval::operator()(G4_Declare *A, G4_Declare *B) const {
   return gra.getEndInterval(A)->getLexicalId() >
@@ -2147,11 +2162,11 @@ void Interference::buildInterferenceWithinBB(G4_BB *bb, llvm_SBitVector &live) {
         }
       } else if (liveAnalysis->livenessClass(G4_ADDRESS)) {
         // assume callee will use A0
-        auto A0Dcl = kernel.fg.fcallToPseudoDclMap[inst->asCFInst()].A0;
+        auto A0Dcl = kernel.fg.fcallToPseudoDclMap.at(inst->asCFInst()).A0;
         buildInterferenceWithLive(live, A0Dcl->getRegVar()->getId());
       } else if (liveAnalysis->livenessClass(G4_FLAG)) {
         // assume callee will use both F0 and F1
-        auto flagDcl = kernel.fg.fcallToPseudoDclMap[inst->asCFInst()].Flag;
+        auto flagDcl = kernel.fg.fcallToPseudoDclMap.at(inst->asCFInst()).Flag;
         buildInterferenceWithLive(live, flagDcl->getRegVar()->getId());
       }
     }
@@ -2435,6 +2450,94 @@ void Interference::setupLRs(G4_BB *bb) {
   }
 }
 
+//
+// The per-BB interference build only reads the IR and liveness, so BBs can be
+// processed concurrently as long as each worker records into its own matrix.
+// Partial and split declares are excluded because buildInterferenceWithLive()
+// also clears edges for them, and clears would make the result depend on the
+// order BBs are visited in. Debug info intervals are shared state too.
+//
+bool Interference::canBuildInterferenceInParallel(unsigned numBBs) const {
+  unsigned numThreads = builder.getuint32Option(vISA_IntfBuildThreads);
+  // Below a couple of BBs per thread, thread startup and the merge cost more
+  // than they save.
+  return numThreads > 1 && numBBs >= 2 * numThreads && splitNum == 0 &&
+         !builder.getOption(vISA_GenerateDebugInfo);
+}
+
+void Interference::buildInterferenceInParallel(
+    const std::vector<G4_BB *> &bbs) {
+  unsigned numThreads = builder.getuint32Option(vISA_IntfBuildThreads);
+  std::vector<InterferenceMatrixStorage> storage(numThreads);
+  std::vector<std::unique_ptr<Interference>> workers(numThreads);
+  for (unsigned i = 0; i < numThreads; ++i) {
+    workers[i].reset(new Interference(*this, storage[i]));
+  }
+
+  parallelFor(numThreads, bbs.size(), [&](unsigned worker, size_t i) {
+    llvm_SBitVector live;
+    workers[worker]->buildInterferenceAtBBExit(bbs[i], live);
+    workers[worker]->buildInterferenceWithinBB(bbs[i], live);
+  });
+
+  if (builder.getOption(vISA_VerifyIntfBuild)) {
+    std::vector<HybridBitSet> merged(maxId);
+    for (auto &s : storage) {
+      for (unsigned i = 0; i < maxId; ++i) {
+        merged[i] |= s.sparseMatrix[i];
+      }
+    }
+    verifyParallelInterference(bbs, merged);
+  }
+
+  // Only edges are added, so the merged matrix doesn't depend on which
+  // worker handled which BB.
+  for (auto &w : workers) {
+    mergeInterference(*w);
+  }
+}
+
+void Interference::mergeInterference(const Interference &other) {
+  vISA_ASSERT(!other.useDenseMatrix(), "worker matrix is expected sparse");
+  for (unsigned i = 0; i < maxId; ++i) {
+    if (useDenseMatrix()) {
+      for (unsigned j : other.sparseMatrix[i]) {
+        safeSetInterference(i, j);
+      }
+    } else {
+      sparseMatrix[i] |= other.sparseMatrix[i];
+    }
+  }
+}
+
+// Builds the interference of bbs serially and checks that it has the same
+// edges as merged, the union of the matrices of the parallel workers.
+void Interference::verifyParallelInterference(
+    const std::vector<G4_BB *> &bbs, const std::vector<HybridBitSet> &merged) {
+  InterferenceMatrixStorage storage;
+  Interference serial(*this, storage);
+  llvm_SBitVector live;
+  for (G4_BB *bb : bbs) {
+    live.clear();
+    serial.buildInterferenceAtBBExit(bb, live);
+    serial.buildInterferenceWithinBB(bb, live);
+  }
+
+  bool match = true;
+  for (unsigned i = 0; i < maxId; ++i) {
+    std::vector<unsigned> expected(storage.sparseMatrix[i].begin(),
+                                   storage.sparseMatrix[i].end());
+    std::vector<unsigned> actual(merged[i].begin(), merged[i].end());
+    if (expected != actual) {
+      std::cerr << "Parallel interference of " << lrs[i]->getDcl()->getName()
+                << " has " << actual.size() << " edges, serial has "
+                << expected.size() << "\n";
+      match = false;
+    }
+  }
+  vISA_ASSERT(match, "parallel interference build differs from serial build");
+}
+
 void Interference::computeInterference() {
   startTimer(TimerID::INTERFERENCE);
 
@@ -2444,29 +2547,37 @@ void Interference::computeInterference() {
     setupLRs(bb);
   }
 
-  //
-  // create bool vector, live, to track live ranges that are currently live
-  //
-  llvm_SBitVector live;
-
   buildInterferenceAmongLiveOuts();
 
+  std::vector<G4_BB *> intfBBs;
   for (G4_BB *bb : kernel.fg) {
-    if (!incRA.intfNeededForBB(bb)) {
-      continue;
+    if (incRA.intfNeededForBB(bb)) {
+      intfBBs.push_back(bb);
     }
+  }
+
+  if (canBuildInterferenceInParallel(intfBBs.size())) {
+    buildInterferenceInParallel(intfBBs);
+  } else {
     //
-    // mark all live ranges dead
-    //
-    live.clear();
-    //
-    // start with all live ranges that are live at the exit of BB
-    //
-    buildInterferenceAtBBExit(bb, live);
-    //
-    // traverse inst in the reverse order
+    // create bool vector, live, to track live ranges that are currently live
     //
-    buildInterferenceWithinBB(bb, live);
+    llvm_SBitVector live;
+
+    for (G4_BB *bb : intfBBs) {
+      //
+      // mark all live ranges dead
+      //
+      live.clear();
+      //
+      // start with all live ranges that are live at the exit of BB
+      //
+      buildInterferenceAtBBExit(bb, live);
+      //
+      // traverse inst in the reverse order
+      //
+      buildInterferenceWithinBB(bb, live);
+    }
   }
 
   buildInterferenceAmongLiveIns();
@@ -9083,6 +9194,12 @@ void GlobalRA::fastRADecision()
     useHybridRAwithSpill = builder.getOption(vISA_HybridRAWithSpill);
   }
 
+  if (kernel.getCompileEffort() >= G4_Kernel::CompileEffort::FastRA) {
+    useFastRA = true;
+    useHybridRAwithSpill = true;
+    RA_TRACE(std::cout << "\t--fast RA for compile-time budget\n");
+  }
+
 }
 
 
@@ -9496,6 +9613,12 @@ int GlobalRA::coloringRegAlloc() {
       doBankConflictReduction = reduceBCInRR && reduceBCInTAandFF;
     }
 
+    // Too large for the compile-time budget, stop trying to get by without
+    // spills
+    if (iterationNo > 0 && iterationNo < failSafeRAIteration &&
+        kernel.getCompileEffort() == G4_Kernel::CompileEffort::FailSafeRA)
+      failSafeRAIteration = iterationNo;
+
     bool allowAddrTaken = builder.getOption(vISA_FastSpill) || fastCompile ||
                           !kernel.getHasAddrTaken();
     if (builder.getOption(vISA_FailSafeRA) &&
@@ -9609,6 +9732,8 @@ int GlobalRA::coloringRegAlloc() {
 
           // Re-run GRA loop only if remat caused changes to IR
           rerunGRA |= remat.getChangesMade();
+          if (remat.getChangesMade())
+            incRA.markAllBBsModified();
         }
 
         if (kernel.getOption(vISA_SplitGRFAlignedScalar) && !fastCompile &&
@@ -9619,6 +9744,8 @@ int GlobalRA::coloringRegAlloc() {
 
           // Re-run GRA loop if changes were made to IR
           rerunGRA |= split.getChangesMade();
+          if (split.getChangesMade())
+            incRA.markAllBBsModified();
           kernel.dumpToFile("after.Split_Aligned_Scalar." + std::to_string(iterationNo));
 #ifndef DLL_MODE
           if (stopAfter("Split_Aligned_Scalar")) {
@@ -9670,6 +9797,7 @@ int GlobalRA::coloringRegAlloc() {
           LoopVarSplit loopSplit(kernel, &coloring, &liveAnalysis);
           kernel.fg.getLoops().computePreheaders();
           loopSplit.run();
+          incRA.markAllBBsModified();
         }
 
         // Very few spills in this iter. Check if we can convert this to fail
@@ -391,9 +391,10 @@ public:
 // This class stores base matrices used for interference building for graph coloring.
 struct InterferenceMatrixStorage {
   // This member is a half triangle representation of interference graph implemented
-  // as a sparse bitvector. Interference construction uses this member. When
-  // incremental RA is enabled, this member is updated incrementally.
-  std::vector<llvm_SBitVector> sparseMatrix;
+  // as a row per variable, each row adapting its format to its density.
+  // Interference construction uses this member. When incremental RA is
+  // enabled, this member is updated incrementally.
+  std::vector<HybridBitSet> sparseMatrix;
   // This member is constructed after SIMT and SIMD interference are computed.
   // It's a full triangle representation of interference matrix with trivial
   // traversal. This member is reconstructed in each graph color iteration.
@@ -408,7 +409,7 @@ struct InterferenceMatrixStorage {
 class IncrementalRA {
   friend Interference;
 
-  const llvm_SBitVector &getSparseMatrix(unsigned int id) {
+  const HybridBitSet &getSparseMatrix(unsigned int id) {
     return sparseMatrix[id];
   }
 
@@ -416,7 +417,7 @@ private:
   GlobalRA &gra;
   G4_Kernel &kernel;
   LiveRangeVec lrs;
-  std::vector<llvm_SBitVector>& sparseMatrix;
+  std::vector<HybridBitSet>& sparseMatrix;
   std::vector<std::vector<unsigned>>& sparseIntf;
   G4_RegFileKind selectedRF = G4_RegFileKind::G4_UndefinedRF;
   unsigned int level = 0;
@@ -504,6 +505,7 @@ public:
     varIdx.clear();
     maxVarIdx = 0;
     reset();
+    markAllBBsModified();
   }
 
   // Return idx of a G4_RegVar if it was given an id in previous
@@ -525,6 +527,7 @@ public:
     if ((RF & selectedRF) == 0) {
       varIdx.clear();
       maxVarIdx = 0;
+      markAllBBsModified();
     }
     if (varIdx.size() == 0)
       return 0;
@@ -565,7 +568,76 @@ public:
 
   void evenAlignUpdate(G4_Declare *dcl) { evenAlignCache.insert(dcl); }
 
+  // Gen/kill sets of a BB computed by GRF liveness along with the pseudo
+  // kills liveness inserted in it. They stay valid until the BB is marked
+  // modified or RA state of a variable it references changes.
+  struct BBGenKill {
+    unsigned char RF = 0;
+    llvm_SBitVector def_out;
+    llvm_SBitVector use_gen;
+    llvm_SBitVector use_kill;
+    // Declare of each pseudo kill and instruction it was inserted before
+    std::vector<std::pair<G4_Declare *, G4_INST *>> pseudoKills;
+  };
+
+  // RA state of a variable that decides how its references in a BB
+  // contribute to gen/kill sets of the BB.
+  struct GenKillVarState {
+    unsigned id = UNDEFINED_VAL;
+    unsigned flags = 0;
+    const G4_INST *localFirstRef = nullptr;
+    BitSet neverDefinedRows;
+
+    bool operator==(const GenKillVarState &other) const {
+      return id == other.id && flags == other.flags &&
+             localFirstRef == other.localFirstRef &&
+             neverDefinedRows == other.neverDefinedRows;
+    }
+    bool operator!=(const GenKillVarState &other) const {
+      return !(*this == other);
+    }
+  };
+
+  // Return gen/kill sets recorded for bb by liveness of RF, nullptr if
+  // there are none.
+  const BBGenKill *getGenKill(const G4_BB *bb, unsigned char RF) const {
+    auto it = genKillCache.find(bb);
+    if (it == genKillCache.end() || it->second.RF != RF)
+      return nullptr;
+    return &it->second;
+  }
+
+  // refs holds root declares referenced in bb.
+  void recordGenKill(const G4_BB *bb, BBGenKill &&genKill,
+                     const std::vector<const G4_Declare *> &refs);
+
+  // Record state of dcl for current liveness. Gen/kill sets of BBs
+  // referencing dcl are dropped if it differs from the state recorded by
+  // previous liveness or if dcl is an incremental RA candidate.
+  void updateGenKillVarState(const G4_Declare *dcl, GenKillVarState &&state);
+
+  // Passes that insert or remove instructions between RA iterations
+  // invoke these so gen/kill sets of affected BBs are recomputed.
+  void markBBModified(const G4_BB *bb) { genKillCache.erase(bb); }
+  void markAllBBsModified() {
+    genKillCache.clear();
+    genKillBBs.clear();
+    genKillVarStates.clear();
+  }
+
+  // Number of LivenessAnalysis instances alive. Gen/kill sets are reused
+  // only by the sole one as others may have inserted pseudo kills.
+  unsigned numLiveLiveness = 0;
+
 private:
+  // Gen/kill sets of last GRF liveness. Unlike other incremental state this
+  // outlives reset() as entries are dropped when they become stale.
+  std::unordered_map<const G4_BB *, BBGenKill> genKillCache;
+  // BBs whose recorded gen/kill sets reference each root declare
+  std::unordered_map<const G4_Declare *, std::vector<const G4_BB *>>
+      genKillBBs;
+  std::unordered_map<const G4_Declare *, GenKillVarState> genKillVarStates;
+
   // For verification only
   std::vector<llvm_SBitVector> def_in;
   std::vector<llvm_SBitVector> def_out;
@@ -620,7 +692,7 @@ class Interference {
   // like dense matrix, interference is not symmetric (that is, if v1 and v2
   // interfere and v1 < v2, we insert (v1, v2) but not (v2, v1)) for better
   // cache behavior
-  std::vector<llvm_SBitVector>& sparseMatrix;
+  std::vector<HybridBitSet>& sparseMatrix;
 
   unsigned int denseMatrixLimit = 0;
 
@@ -715,6 +787,16 @@ class Interference {
 
   void setupLRs(G4_BB *bb);
 
+  // Creates an empty sparse matrix for the variables of intf in storage,
+  // sharing everything else with intf. Workers of the parallel build record
+  // interference into such matrices that are then merged into the one of intf.
+  Interference(const Interference &intf, InterferenceMatrixStorage &storage);
+  bool canBuildInterferenceInParallel(unsigned numBBs) const;
+  void buildInterferenceInParallel(const std::vector<G4_BB *> &bbs);
+  void mergeInterference(const Interference &other);
+  void verifyParallelInterference(const std::vector<G4_BB *> &bbs,
+                                  const std::vector<HybridBitSet> &merged);
+
 public:
   Interference(const LivenessAnalysis *l, GlobalRA &g);
 
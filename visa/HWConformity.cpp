@@ -6609,7 +6609,7 @@ bool HWConformity::splitInstListForByteDst(INST_LIST_ITER it, G4_BB *bb,
   }
 
   // recursively the inst that defines its predicate can be split
-  INST_LIST expandOpList;
+  std::vector<G4_INST *> expandOpList;
   bool canSplit = canSplitInst(inst, NULL);
   if (canSplit) {
     expandOpList.push_back(inst);
@@ -6653,9 +6653,7 @@ bool HWConformity::splitInstListForByteDst(INST_LIST_ITER it, G4_BB *bb,
   INST_LIST_ITER new_iter = it;
   new_iter++;
   if (canSplit) {
-    while (!expandOpList.empty()) {
-      G4_INST *expand_op = expandOpList.front();
-      expandOpList.pop_front();
+    for (G4_INST *expand_op : expandOpList) {
       // find location of expand_op in instruction list
       do {
         new_iter--;
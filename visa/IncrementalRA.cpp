@@ -349,6 +349,32 @@ void IncrementalRA::skipIncrementalRANextIter() {
   // we can invoke this method to skip running incremental RA
   // in following iteration.
   reset();
+  markAllBBsModified();
+}
+
+void IncrementalRA::recordGenKill(const G4_BB *bb, BBGenKill &&genKill,
+                                  const std::vector<const G4_Declare *> &refs) {
+  if (!genKillCache.count(bb)) {
+    for (auto *dcl : refs)
+      genKillBBs[dcl].push_back(bb);
+  }
+  genKillCache[bb] = std::move(genKill);
+}
+
+void IncrementalRA::updateGenKillVarState(const G4_Declare *dcl,
+                                          GenKillVarState &&state) {
+  auto &prevState = genKillVarStates[dcl];
+  if (prevState == state &&
+      !needIntfUpdate.count(const_cast<G4_Declare *>(dcl)))
+    return;
+  prevState = std::move(state);
+
+  auto it = genKillBBs.find(dcl);
+  if (it == genKillBBs.end())
+    return;
+  for (auto *bb : it->second)
+    genKillCache.erase(bb);
+  genKillBBs.erase(it);
 }
 
 bool IncrementalRA::verify(const LivenessAnalysis *curLiveness) const {
@@ -7,6 +7,7 @@ SPDX-License-Identifier: MIT
 ============================= end_copyright_notice ===========================*/
 
 #include "../GraphColor.h"
+#include "../ParallelFor.h"
 #include "../PointsToAnalysis.h"
 #include "LocalScheduler_G4IR.h"
 #include "Passes/AccSubstitution.hpp"
@@ -23,6 +24,7 @@ SPDX-License-Identifier: MIT
 #include <iostream>
 #include <limits>
 #include <list>
+#include <memory>
 #include <optional>
 #include <queue>
 
@@ -324,6 +326,7 @@ struct RegisterPressure {
   LivenessAnalysis *liveness = nullptr;
   RPE *rpe = nullptr;
   G4_Kernel &kernel;
+  bool OwnsRPE = false;
 
   RegisterPressure(G4_Kernel &kernel, RPE *rpe) : rpe(rpe), kernel(kernel) {
     // Initialize rpe if not available.
@@ -335,6 +338,15 @@ struct RegisterPressure {
     }
   }
 
+  // Shares the analyses of Base but tracks pressure with an RPE of its own,
+  // so that blocks can be scheduled concurrently. The pressure of a block is
+  // only available after it is recomputed.
+  RegisterPressure(G4_Kernel &kernel, const RegisterPressure &Base)
+      : gra(Base.gra), liveness(Base.liveness), kernel(kernel),
+        OwnsRPE(true) {
+    rpe = new RPE(*gra, liveness);
+  }
+
   ~RegisterPressure() {
     // Delete only if owns the following objects.
     if (p2a) {
@@ -342,6 +354,8 @@ struct RegisterPressure {
       delete gra;
       delete liveness;
       delete rpe;
+    } else if (OwnsRPE) {
+      delete rpe;
     }
   }
 
@@ -574,57 +588,126 @@ bool preRA_Scheduler::run(unsigned &KernelPressure) {
   unsigned Threshold = getRPReductionThreshold(kernel);
   unsigned SchedCtrl = kernel.getuInt32Option(vISA_preRA_ScheduleCtrl);
 
-  auto LT = LatencyTable::createLatencyTable(*kernel.fg.builder);
+  const LatencyTable &LT = LatencyTable::get(*kernel.fg.builder);
   SchedConfig config(SchedCtrl);
   RegisterPressure rp(kernel, nullptr);
   // skip extreme test cases that scheduling does not good
   // if (kernel.fg.getNumBB() >= 10000 && rp.rpe->getMaxRP() >= 800)
   //   return false;
 
-  bool Changed = false;
-  for (auto bb : kernel.fg) {
+  auto isCandidate = [&](G4_BB *bb, unsigned &MaxPressure) {
     if (bb->size() < SMALL_BLOCK_SIZE || bb->size() > LARGE_BLOCK_SIZE) {
       SCHED_DUMP(std::cerr << "Skip block with instructions " << bb->size()
                            << "\n");
-      continue;
+      return false;
     }
 
     if (kernel.getuInt32Option(vISA_ScheduleStartBBID) &&
         (bb->getId() <
          kernel.getuInt32Option(vISA_ScheduleStartBBID))) {
       SCHED_DUMP(std::cerr << "Skip BB" << bb->getId() << "\n");
-      continue;
+      return false;
     }
 
     if (kernel.getuInt32Option(vISA_ScheduleEndBBID) &&
         (bb->getId() >
          kernel.getuInt32Option(vISA_ScheduleEndBBID))) {
       SCHED_DUMP(std::cerr << "Skip BB" << bb->getId() << "\n");
-      continue;
+      return false;
     }
 
-    unsigned MaxPressure = rp.getPressure(bb);
+    MaxPressure = rp.getPressure(bb);
     if (MaxPressure <= Threshold && !config.UseLatency) {
       SCHED_DUMP(std::cerr << "Skip block with rp " << MaxPressure << "\n");
-      continue;
+      return false;
     }
+    return true;
+  };
 
-    SCHED_DUMP(rp.dump(bb, "Before scheduling, "));
-    preDDD ddd(kernel, bb);
-    BB_Scheduler S(kernel, ddd, rp, config, *LT);
+  bool Changed = false;
+  unsigned WorkerMaxRP = 0;
+  unsigned NumThreads = kernel.getuInt32Option(vISA_preRA_ScheduleThreads);
+  // Dumps are written while scheduling, keep them in block order.
+  if (NumThreads > 1 && !config.Dump &&
+      !kernel.getOption(vISA_DumpDagTxt)) {
+    std::vector<std::pair<G4_BB *, unsigned>> Blocks;
+    for (auto bb : kernel.fg) {
+      unsigned MaxPressure = 0;
+      if (isCandidate(bb, MaxPressure))
+        Blocks.emplace_back(bb, MaxPressure);
+    }
+
+    // Scheduling a block only reorders its own instructions and updates the
+    // pressure of that block, so each worker tracks pressure on its own and
+    // the kernel pressure is recomputed once all blocks are done.
+    std::vector<std::unique_ptr<RegisterPressure>> WorkerRP(NumThreads);
+    for (auto &WRP : WorkerRP)
+      WRP.reset(new RegisterPressure(kernel, rp));
+    std::vector<char> WorkerChanged(NumThreads, false);
+    auto scheduleBlock = [&](unsigned Worker, size_t i, bool PriorChanged) {
+      G4_BB *bb = Blocks[i].first;
+      unsigned MaxPressure = Blocks[i].second;
+      RegisterPressure &WRP = *WorkerRP[Worker];
+      WRP.recompute(bb);
+      preDDD ddd(kernel, bb);
+      BB_Scheduler S(kernel, ddd, WRP, config, LT);
+
+      bool BBChanged = S.scheduleBlockForPressure(MaxPressure, Threshold);
+      BBChanged |= S.scheduleBlockForLatency(
+          MaxPressure, PriorChanged || BBChanged, 0);
+      if (BBChanged)
+        WorkerChanged[Worker] = true;
+      return BBChanged;
+    };
+    {
+      // Reordering allocates list nodes from the arena shared by the
+      // instruction lists of all blocks.
+      Mem_Manager::ConcurrentScope Scope(
+          kernel.fg.instListAlloc.getMemManager());
+      // As in the serial loop, latency scheduling reassigns node IDs once any
+      // block so far has changed. Blocks are scheduled in order up to the
+      // first one that changes, and all later ones reassign their IDs.
+      size_t First = 0;
+      while (First < Blocks.size() && !scheduleBlock(0, First, false))
+        ++First;
+      if (First < Blocks.size())
+        ++First;
+      parallelFor(NumThreads, Blocks.size() - First,
+                  [&](unsigned Worker, size_t i) {
+                    scheduleBlock(Worker, First + i, true);
+                  });
+    }
+
+    for (unsigned i = 0; i < NumThreads; ++i) {
+      Changed |= WorkerChanged[i] != 0;
+      WorkerMaxRP = std::max(WorkerMaxRP, WorkerRP[i]->getMaxRP());
+    }
+  } else {
+    for (auto bb : kernel.fg) {
+      unsigned MaxPressure = 0;
+      if (!isCandidate(bb, MaxPressure))
+        continue;
 
-    Changed |= S.scheduleBlockForPressure(MaxPressure, Threshold);
-    Changed |= S.scheduleBlockForLatency(MaxPressure, Changed, 0);
+      SCHED_DUMP(rp.dump(bb, "Before scheduling, "));
+      preDDD ddd(kernel, bb);
+      BB_Scheduler S(kernel, ddd, rp, config, LT);
+
+      Changed |= S.scheduleBlockForPressure(MaxPressure, Threshold);
+      Changed |= S.scheduleBlockForLatency(MaxPressure, Changed, 0);
+    }
   }
 
   if (Changed)
     rp.recompute();
-  KernelPressure = rp.getMaxRP();
+  // The pressure of schedules tried along the way counts as well, as it does
+  // when scheduling serially.
+  KernelPressure = std::max(rp.getMaxRP(), WorkerMaxRP);
 
   return Changed;
 }
 
-preRA_RegSharing::preRA_RegSharing(G4_Kernel &k) : kernel(k) {}
+preRA_RegSharing::preRA_RegSharing(G4_Kernel &k, bool ScheduleBlocks)
+    : kernel(k), ScheduleBlocks(ScheduleBlocks) {}
 
 preRA_RegSharing::~preRA_RegSharing() {}
 
@@ -642,8 +725,18 @@ bool preRA_RegSharing::run(unsigned &KernelPressure) {
   SchedConfig config(SchedCtrl);
   RegisterPressure rp(kernel, nullptr);
   KernelPressure = rp.getMaxRP();
+
+  if (!ScheduleBlocks) {
+    // Select the GRF mode as below, from the unscheduled pressure.
+    kernel.updateKernelByRegPressure(KernelPressure);
+    unsigned ExtraRegs = (unsigned)(kernel.getNumRegTotal() *
+                                    EXTRA_REGISTERS_FOR_RA / 100.0f);
+    kernel.updateKernelByRegPressure(KernelPressure + ExtraRegs);
+    return false;
+  }
+
   unsigned RPReductionThreshold = getRPReductionThreshold(kernel);
-  auto LT = LatencyTable::createLatencyTable(*kernel.fg.builder);
+  const LatencyTable &LT = LatencyTable::get(*kernel.fg.builder);
 
   // Schedule for reg pressure reduction if needed
   for (auto bb : kernel.fg) {
@@ -669,7 +762,7 @@ bool preRA_RegSharing::run(unsigned &KernelPressure) {
     // Schedule:
     SCHED_DUMP(rp.dump(bb, "Before scheduling for pressure reduction, "));
     preDDD ddd(kernel, bb);
-    BB_Scheduler S(kernel, ddd, rp, config, *LT);
+    BB_Scheduler S(kernel, ddd, rp, config, LT);
     unsigned BBRP = rp.getPressure(bb);
     Changed |= S.scheduleBlockForPressure(BBRP, RPReductionThreshold);
   }
@@ -710,7 +803,7 @@ bool preRA_RegSharing::run(unsigned &KernelPressure) {
     // Schedule:
     SCHED_DUMP(rp.dump(bb, "Before scheduling for latency hiding, "));
     preDDD ddd(kernel, bb);
-    BB_Scheduler S(kernel, ddd, rp, config, *LT);
+    BB_Scheduler S(kernel, ddd, rp, config, LT);
     unsigned BBRP = rp.getPressure(bb);
 
     unsigned UpperBoundGRF = 0;
@@ -9,7 +9,12 @@ SPDX-License-Identifier: MIT
 #include "LatencyTable.h"
 #include "../G4_IR.hpp"
 #include "LocalScheduler_G4IR.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <type_traits>
+#include <utility>
 
 using namespace vISA;
 
@@ -19,167 +24,158 @@ inline std::underlying_type_t<Enum> value_of(Enum val) {
   return static_cast<std::underlying_type_t<Enum>>(val);
 }
 
-class LatencyTableLegacy : public LatencyTable {
-public:
-  LatencyTableLegacy(const IR_Builder& builder) : LatencyTable(builder) {
-    vASSERT(builder.getPlatformGeneration() < PlatformGen::XE);
+const LatencyTable &LatencyTable::get(const IR_Builder &builder) {
+  // The tables only depend on the platform and on whether L1 hits are
+  // assumed, so every kernel of the process compiled with the same settings
+  // shares one instance. Instances live until the process exits.
+  static std::mutex TablesMutex;
+  static std::map<std::pair<TARGET_PLATFORM, bool>,
+                  std::unique_ptr<LatencyTable>>
+      Tables;
+
+  auto Key = std::make_pair(builder.getPlatform(),
+                            builder.getOption(vISA_assumeL1Hit));
+  std::lock_guard<std::mutex> Lock(TablesMutex);
+  auto &Table = Tables[Key];
+  if (!Table)
+    Table.reset(new LatencyTable(Key.first, builder.getPlatformGeneration(),
+                                 Key.second));
+  return *Table;
+}
+
+LatencyTable::LatencyTable(TARGET_PLATFORM Platform, PlatformGen Gen,
+                           bool AssumeL1Hit)
+    : Platform(Platform), Gen(Gen), AssumeL1Hit(AssumeL1Hit) {
+  for (int Op = 0; Op < G4_NUM_OPCODE; ++Op)
+    OpKinds[Op] = OpKind::Other;
+  OpKinds[G4_send] = OpKinds[G4_sendc] = OpKind::Send;
+  OpKinds[G4_sends] = OpKinds[G4_sendsc] = OpKind::Send;
+  OpKinds[G4_math] = OpKind::Math;
+  std::fill(std::begin(DPASLatency), std::end(DPASLatency),
+            (uint16_t)LegacyLatencies::UNKNOWN_LATENCY);
+
+  if (Gen >= PlatformGen::XE)
+    initXe();
+  else
+    initLegacy();
+}
+
+void LatencyTable::initLegacy() {
+  BranchLatency = LegacyLatencies::IVB_PIPELINE_LENGTH;
+  IntrinsicLatency = LegacyLatencies::IVB_PIPELINE_LENGTH;
+  ARFLatency = LegacyLatencies::IVB_PIPELINE_LENGTH;
+  DefaultLatency = LegacyLatencies::IVB_PIPELINE_LENGTH;
+  for (unsigned Sz = 0; Sz <= MAX_EXEC_SIZE; ++Sz) {
+    MathLatency[0][Sz] = LegacyLatencies::EDGE_LATENCY_MATH;
+    MathLatency[1][Sz] = LegacyLatencies::EDGE_LATENCY_MATH_TYPE2;
+    ArithLatency[0][Sz] = ArithLatency[1][Sz] =
+        LegacyLatencies::IVB_PIPELINE_LENGTH;
   }
-  uint16_t getLatency(const G4_INST *Inst) const override;
-  uint16_t getOccupancy(const G4_INST *Inst) const override;
-  uint16_t getDPASLatency(uint8_t repeatCount) const override;
-};
 
-template <PlatformGen Gen>
-class LatencyTableXe: public LatencyTable {
-  // Select latency information based on platform generation.
-  using LI = typename std::conditional<Gen >= PlatformGen::XE,
-                                       XELatencyInfo,
-                                       void>::type;
-public:
-  LatencyTableXe(const IR_Builder& builder) : LatencyTable(builder) {
-    static_assert(Gen >= PlatformGen::XE);
-  }
-  // General implementations to get latency and occupancy for the given
-  // instruction based on heuristics. The implementation can be specialized if
-  // needed.
-  uint16_t getLatency(const G4_INST *Inst) const override;
-  uint16_t getOccupancy(const G4_INST *Inst) const override;
-
-  // The details of heuristics used to calculate the latency. The
-  // implementation can be specialized if needed.
-  uint16_t getDPASLatency(uint8_t repeatCount) const override;
-private:
-  uint16_t getMsgLatency(const G4_INST *Inst) const;
-  uint16_t getMathLatency(const G4_INST *inst) const;
-  uint16_t getBranchLatency(const G4_INST *inst) const;
-  uint16_t getIntrinsicLatency(const G4_INST *inst) const;
-  uint16_t getDPASLatency(const G4_InstDpas *dpas) const;
-  uint16_t getARFAccessLatency(const G4_INST *inst) const;
-  uint16_t getArithmeticLatency(const G4_INST *inst) const;
-};
-
-std::unique_ptr<LatencyTable>
-LatencyTable::createLatencyTable(const IR_Builder &builder) {
-  auto GEN = builder.getPlatformGeneration();
-  if (GEN >= PlatformGen::XE)
-    return std::make_unique<LatencyTableXe<PlatformGen::XE>>(builder);
-
-  return std::make_unique<LatencyTableLegacy>(builder);
-}
-
-uint16_t LatencyTableLegacy::getLatency(const G4_INST *Inst) const {
-  if (Inst->isSend()) {
-    G4_SendDesc *MsgDesc = Inst->getMsgDesc();
-    int SFIDint = SFIDtoInt(MsgDesc->getSFID());
-    vASSERT(SFIDint < ARRAY_COUNT(LegacyFFLatency));
-    return LegacyFFLatency[SFIDint];
-  } else if (Inst->isMath()) {
-    if (Inst->asMathInst()->getMathCtrl() == MATH_FDIV ||
-        Inst->asMathInst()->getMathCtrl() == MATH_POW)
-      return LegacyLatencies::EDGE_LATENCY_MATH_TYPE2;
-    return LegacyLatencies::EDGE_LATENCY_MATH;
-  }
-  return LegacyLatencies::IVB_PIPELINE_LENGTH;
-}
-
-// This calculates the node's pipeline occupancy (node delay)
-uint16_t LatencyTableLegacy::getOccupancy(const G4_INST *Inst) const {
-  int divisor = 8;
-  int InstLatency = LegacyLatencies::UNCOMPR_LATENCY;
-  if (Inst->isFastHFInstruction()) {
-    divisor = 16;
-  }
-
-  // Number of n-wide passes in FPU0 or FPU1 (EM).
-  // "n" is:
+  // Occupancy is the number of n-wide passes in FPU0 or FPU1 (EM) times the
+  // instruction latency. "n" is:
   //      16 for BDW+ HalfFloatDoublePerf instructions,
   //      8 for other instructions.
-  int passes = std::max(1, Inst->getExecSize() / divisor);
+  for (unsigned Sz = 0; Sz <= MAX_EXEC_SIZE; ++Sz) {
+    Passes[Sz] = QWordPasses[Sz] = (uint16_t)std::max(1u, Sz / 8);
+    FastHFPasses[Sz] = (uint16_t)std::max(1u, Sz / 16);
+  }
 
-  // InstLatency is:
+  // The instruction latency is:
   //      4 for EM/FPU1 POW and FDIV instructions ( HSW; for BDW+ it is 2 times
   //      higher ), 2 for other EM/FPU1 instructions ( HSW; for BDW+ it is 2
   //      times higher ), 2 for other instructions.
-  // Update DagNode latency for math.
-  G4_opcode opCode = Inst->opcode();
-  switch (opCode) {
-  case G4_math: {
-    // Use EdgeLatencyMathType2 for FDIV, FPOW functions.
-    if (Inst->asMathInst()->getMathCtrl() == MATH_FDIV ||
-        Inst->asMathInst()->getMathCtrl() == MATH_POW) {
-      InstLatency = 4;
-    } else {
-      // Used EdgeLatencyMath for other functions.
-      InstLatency = 2;
+  // BDW+ platforms have lower math TPT and longer latency (all math
+  // functions).
+  for (unsigned Sz = 0; Sz <= MAX_EXEC_SIZE; ++Sz) {
+    for (int FastHF = 0; FastHF < 2; ++FastHF) {
+      uint16_t P = FastHF ? FastHFPasses[Sz] : Passes[Sz];
+      MathOccupancy[0][FastHF][Sz] = 2 * 2 * P;
+      MathOccupancy[1][FastHF][Sz] = 4 * 2 * P;
     }
-
-    // BDW+ platforms have lower math TPT and longer latency (all math
-    // functions).
-    InstLatency *= 2;
-    break;
   }
-  case G4_bfe:
-  case G4_bfi1:
-  case G4_bfi2:
-  case G4_bfrev:
-  case G4_cbit:
-  case G4_dp2:
-  case G4_dp3:
-  case G4_dp4:
-  case G4_dph:
-  case G4_fbh:
-  case G4_fbl:
-  case G4_lrp:
-  case G4_mac:
-  case G4_mach:
-  case G4_pln:
-    InstLatency *= 2;
-    break;
-  case G4_label:
-    // Labels need special care. They should have a latency of 1.
-    // But their execSize is 255, which sets passes=31.
-    passes = 1;
-    InstLatency = 1;
-    break;
-  default:
-    break;
+  for (int Op = 0; Op < G4_NUM_OPCODE; ++Op)
+    OpOccupancy[Op] = LegacyLatencies::UNCOMPR_LATENCY;
+  for (G4_opcode Op : {G4_bfe, G4_bfi1, G4_bfi2, G4_bfrev, G4_cbit, G4_dp2,
+                       G4_dp3, G4_dp4, G4_dph, G4_fbh, G4_fbl, G4_lrp, G4_mac,
+                       G4_mach, G4_pln})
+    OpOccupancy[Op] = 2 * LegacyLatencies::UNCOMPR_LATENCY;
+  // Labels need special care. They should have a latency of 1.
+  // But their execSize is 255, which sets passes=31.
+  LabelOccupancy = 1;
+}
+
+void LatencyTable::initXe() {
+  using LI = XELatencyInfo;
+  for (int Op = 0; Op < G4_NUM_OPCODE; ++Op) {
+    if (G4_Inst_Table[Op].instType == InstTypeFlow)
+      OpKinds[Op] = OpKind::Branch;
+    else if (G4_Inst_Table[Op].instType == InstTypeArith)
+      OpKinds[Op] = OpKind::Arithmetic;
   }
+  OpKinds[G4_math] = OpKind::Math;
+  OpKinds[G4_intrinsic] = OpKind::Intrinsic;
+  OpKinds[G4_dpas] = OpKinds[G4_dpasw] = OpKind::Dpas;
 
-  return uint16_t(passes * InstLatency);
-}
-
-uint16_t LatencyTableLegacy::getDPASLatency(uint8_t repeatCount) const {
-  vISA_ASSERT_UNREACHABLE("DPAS is not supported");
-  return LegacyLatencies::UNKNOWN_LATENCY;
-}
+  BranchLatency = value_of(LI::BRANCH);
+  IntrinsicLatency = value_of(LI::FPU);
+  ARFLatency = value_of(LI::ARF);
+  // By default, use the FPU pipeline latency.
+  DefaultLatency = value_of(LI::FPU);
+  for (unsigned Sz = 0; Sz <= MAX_EXEC_SIZE; ++Sz) {
+    int Scale = (Sz <= 8) ? 0 : (Sz == 16) ? 1 : 3;
+    MathLatency[0][Sz] = MathLatency[1][Sz] =
+        value_of(LI::MATH) + value_of(LI::DELTA_MATH) * Scale;
+    ArithLatency[0][Sz] = value_of(LI::FPU) + value_of(LI::DELTA) * Scale;
+    ArithLatency[1][Sz] = value_of(LI::FPU_ACC) + value_of(LI::DELTA) * Scale;
+  }
 
-// General template implementations for XE+.
-template<PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getLatency(const G4_INST *Inst) const {
-  if (Inst->isSend())
-    return getMsgLatency(Inst);
-  if (Inst->isMath())
-    return getMathLatency(Inst);
-  if (Inst->isFlowControl())
-    return getBranchLatency(Inst);
-  if (Inst->isIntrinsic())
-    return getIntrinsicLatency(Inst);
-  if (Inst->isDpas())
-    return getDPASLatency(Inst->asDpasInst());
-  if (Inst->writesFlag() ||
-      (Inst->getDst() && Inst->getDst()->isDirectA0()))
-    return getARFAccessLatency(Inst);
-  if (Inst->isArithmetic())
-    return getArithmeticLatency(Inst);
+  for (unsigned RepeatCount = 0; RepeatCount <= MAX_DPAS_REPEAT;
+       ++RepeatCount) {
+    uint16_t &Latency = DPASLatency[RepeatCount];
+    switch (Platform) {
+    case Xe_XeHPSDV:
+    case Xe_PVC:
+      Latency = value_of(LI::DPAS) + RepeatCount - 1;
+      break;
+    case Xe_DG2:
+      Latency = RepeatCount == 1 ? 21 : RepeatCount == 2 ? 22 : 32;
+      break;
+    case Xe_PVCXT:
+      Latency = value_of(LI::DPAS) + RepeatCount;
+      break;
+    default: // Not supported platform
+      // TODO: Add vISA_ASSERT_UNREACHABLE.
+      Latency = 46;
+      break;
+    }
+  }
 
-  // By default, use the FPU pipeline latency.
-  return value_of(LI::FPU);
+  // TODO: Update PVC+ to consider native exec size as well.
+  for (unsigned Sz = 0; Sz <= MAX_EXEC_SIZE; ++Sz) {
+    uint16_t Scale = (Sz <= 8) ? 1 : (Sz == 16) ? 2 : 4;
+    Passes[Sz] = value_of(LI::OC_OTHERS) * Scale;
+    FastHFPasses[Sz] = value_of(LI::OC_OTHERS) * ((Sz <= 16) ? 1 : 2);
+    QWordPasses[Sz] = value_of(LI::OC_OTHERS) * ((Sz <= 4) ? 1 : 2);
+    for (int LongMath = 0; LongMath < 2; ++LongMath)
+      for (int FastHF = 0; FastHF < 2; ++FastHF)
+        MathOccupancy[LongMath][FastHF][Sz] = value_of(LI::OC_MATH) * Scale;
+  }
+  for (int Op = 0; Op < G4_NUM_OPCODE; ++Op)
+    OpOccupancy[Op] = 1;
+  LabelOccupancy = Passes[MAX_EXEC_SIZE];
 }
 
-template<PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getMsgLatency(const G4_INST *Inst) const {
+uint16_t LatencyTable::getMsgLatency(const G4_INST *Inst) const {
   vASSERT(Inst->isSend());
+  using LI = XELatencyInfo;
   G4_SendDesc *MsgDesc = Inst->getMsgDesc();
+  if (Gen < PlatformGen::XE) {
+    int SFIDint = SFIDtoInt(MsgDesc->getSFID());
+    vASSERT(SFIDint < ARRAY_COUNT(LegacyFFLatency));
+    return LegacyFFLatency[SFIDint];
+  }
+
   if (MsgDesc->isLSC()) {
     if (MsgDesc->getSFID() == SFID::SLM) {
       auto Sz = Inst->getExecSize();
@@ -193,7 +189,7 @@ uint16_t LatencyTableXe<Gen>::getMsgLatency(const G4_INST *Inst) const {
     } else {
       bool isCachedInL1 = MsgDesc->getCachingL1() == Caching::CA ||
                           (MsgDesc->getCachingL1() != Caching::UC &&
-                           m_builder.getOption(vISA_assumeL1Hit));
+                           AssumeL1Hit);
       if (MsgDesc->isTyped()) {
         return isCachedInL1 ? value_of(LI::LSC_TYPED_L1)
                             : value_of(LI::LSC_TYPED_L3);
@@ -214,131 +210,3 @@ uint16_t LatencyTableXe<Gen>::getMsgLatency(const G4_INST *Inst) const {
     return value_of(LI::BARRIER);
   return value_of(LI::SEND_OTHERS);
 }
-
-template<PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getMathLatency(const G4_INST *Inst) const {
-  vASSERT(Inst->isMath());
-  return value_of(LI::MATH);
-}
-
-template<PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getBranchLatency(const G4_INST *Inst) const {
-  vASSERT(Inst->isFlowControl());
-  return value_of(LI::BRANCH);
-}
-
-template<PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getIntrinsicLatency(const G4_INST *Inst) const {
-  vASSERT(Inst->isIntrinsic());
-  return value_of(LI::FPU);
-}
-
-template<PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getDPASLatency(const G4_InstDpas *dpas) const {
-  return getDPASLatency(dpas->getRepeatCount());
-}
-
-template<PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getARFAccessLatency(const G4_INST *Inst) const {
-  vASSERT(Inst->writesFlag() ||
-          (Inst->getDst() && Inst->getDst()->isDirectA0()));
-  return value_of(LI::ARF);
-}
-
-template<PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getArithmeticLatency(const G4_INST *Inst) const {
-  vASSERT(Inst->isArithmetic());
-  auto Dst = Inst->getDst();
-  if (Dst && Dst->isAccReg())
-    return value_of(LI::FPU_ACC);
-  return value_of(LI::FPU);
-}
-
-template <PlatformGen Gen>
-uint16_t LatencyTableXe<Gen>::getOccupancy(const G4_INST *Inst) const {
-  auto Sz = Inst->getExecSize();
-  auto NativeSz = m_builder.getNativeExecSize();
-  uint16_t Scale = (Sz <= NativeSz) ? 1 : (Sz == NativeSz * 2) ? 2 : 4;
-  if (Inst->isMath())
-    return value_of(LI::OC_MATH) * Scale;
-  if (Inst->isFastHFInstruction())
-    Scale = (Sz <= NativeSz * 2) ? 1 : 2;
-  else if (G4_DstRegRegion *Dst = Inst->getDst()) {
-    if (Dst->getTypeSize() == 8)
-      Scale = (Sz <= NativeSz / 2) ? 1 : 2;
-  }
-  return value_of(LI::OC_OTHERS) * Scale;
-}
-
-// XE Specializations.
-template <>
-uint16_t
-LatencyTableXe<PlatformGen::XE>::getDPASLatency(uint8_t repeatCount) const {
-  switch (m_builder.getPlatform()) {
-  case Xe_XeHPSDV:
-    return value_of(LI::DPAS) + repeatCount - 1;
-  case Xe_DG2:
-    switch (repeatCount) {
-    case 1:
-      return 21;
-    case 2:
-      return 22;
-    case 8:
-      return 32;
-    default:
-      return 32;
-    }
-  case Xe_PVC:
-    return value_of(LI::DPAS) + repeatCount - 1;
-  case Xe_PVCXT:
-    return value_of(LI::DPAS) + repeatCount;
-  default: // Not supported platform
-    // TODO: Add vISA_ASSERT_UNREACHABLE.
-    return 46;
-  }
-}
-template<>
-uint16_t
-LatencyTableXe<PlatformGen::XE>::getMathLatency(const G4_INST *Inst) const {
-  vASSERT(Inst->isMath());
-  int Sz = Inst->getExecSize();
-  int Scale = Scale = (Sz <= 8) ? 0 : (Sz == 16) ? 1 : 3;
-  return value_of(LI::MATH) + value_of(LI::DELTA_MATH) * Scale;
-}
-
-template<>
-uint16_t LatencyTableXe<PlatformGen::XE>::getDPASLatency(
-    const G4_InstDpas *dpas) const {
-  return getDPASLatency(dpas->getRepeatCount());
-}
-
-template<>
-uint16_t LatencyTableXe<PlatformGen::XE>::getArithmeticLatency(
-    const G4_INST *Inst) const {
-  vASSERT(Inst->isArithmetic());
-  int Sz = Inst->getExecSize();
-  int Scale = Scale = (Sz <= 8) ? 0 : (Sz == 16) ? 1 : 3;
-  auto Delta = value_of(LI::DELTA) * Scale;
-  auto Dst = Inst->getDst();
-  if (Dst && Dst->isAccReg())
-    return value_of(LI::FPU_ACC) + Delta;
-  return value_of(LI::FPU) + Delta;
-}
-
-// TODO: Update PVC+ to consider native exec size as well so that the
-// specialization can be removed.
-template <>
-uint16_t
-LatencyTableXe<PlatformGen::XE>::getOccupancy(const G4_INST *Inst) const {
-  int Sz = Inst->getExecSize();
-  int Scale = (Sz <= 8) ? 1 : (Sz == 16) ? 2 : 4;
-  if (Inst->isMath())
-    return value_of(LI::OC_MATH) * Scale;
-  if (Inst->isFastHFInstruction())
-    Scale = (Sz <= 16) ? 1 : 2;
-  else if (G4_DstRegRegion *Dst = Inst->getDst()) {
-    if (Dst->getTypeSize() == 8)
-      Scale = (Sz <= 4) ? 1 : 2;
-  }
-  return value_of(LI::OC_OTHERS) * Scale;
-}
@@ -95,23 +95,123 @@ enum class XELatencyInfo : uint16_t {
   OC_OTHERS = 1,
 };
 
+// Latencies and occupancies of one platform, precomputed per opcode and
+// execution size. A table is built once per platform configuration and
+// shared read-only by all kernels and threads, so the schedulers get it
+// through get() rather than building their own. Only send latencies are not
+// a table lookup, they depend on the message descriptor.
 class LatencyTable {
 public:
-  explicit LatencyTable(const IR_Builder &builder) : m_builder(builder) {}
-
-  virtual ~LatencyTable() = default;
-
-  static std::unique_ptr<LatencyTable> createLatencyTable(
-      const IR_Builder &builder);
-
-  // Functions to get latencies/occupancy based on platforms
-  virtual uint16_t getLatency(const G4_INST *Inst) const = 0;
-  virtual uint16_t getOccupancy(const G4_INST *Inst) const = 0;
-  // Implement different platform overrides for DPAS
-  virtual uint16_t getDPASLatency(uint8_t repeatCount) const = 0;
-
-protected:
-  const IR_Builder &m_builder;
+  // Return the shared table for the builder's platform and options.
+  static const LatencyTable &get(const IR_Builder &builder);
+
+  uint16_t getLatency(const G4_INST *Inst) const {
+    G4_opcode Op = Inst->opcode();
+    unsigned Sz = execSizeIndex(Inst);
+    switch (OpKinds[Op]) {
+    case OpKind::Send:
+      return getMsgLatency(Inst);
+    case OpKind::Math:
+      return MathLatency[isLongMath(Inst)][Sz];
+    case OpKind::Branch:
+      return BranchLatency;
+    case OpKind::Intrinsic:
+      return IntrinsicLatency;
+    case OpKind::Dpas:
+      return getDPASLatency(Inst->asDpasInst()->getRepeatCount());
+    default:
+      break;
+    }
+    if (Inst->writesFlag() ||
+        (Inst->getDst() && Inst->getDst()->isDirectA0()))
+      return ARFLatency;
+    if (OpKinds[Op] == OpKind::Arithmetic) {
+      auto Dst = Inst->getDst();
+      return ArithLatency[Dst && Dst->isAccReg()][Sz];
+    }
+    return DefaultLatency;
+  }
+
+  uint16_t getOccupancy(const G4_INST *Inst) const {
+    G4_opcode Op = Inst->opcode();
+    if (Op == G4_label)
+      return LabelOccupancy;
+    unsigned Sz = execSizeIndex(Inst);
+    bool FastHF = Inst->isFastHFInstruction();
+    if (Op == G4_math)
+      return MathOccupancy[isLongMath(Inst)][FastHF][Sz];
+    if (FastHF)
+      return OpOccupancy[Op] * FastHFPasses[Sz];
+    if (G4_DstRegRegion *Dst = Inst->getDst()) {
+      if (Dst->getTypeSize() == 8)
+        return OpOccupancy[Op] * QWordPasses[Sz];
+    }
+    return OpOccupancy[Op] * Passes[Sz];
+  }
+
+  uint16_t getDPASLatency(uint8_t repeatCount) const {
+    vISA_ASSERT(repeatCount <= MAX_DPAS_REPEAT &&
+                    DPASLatency[repeatCount] != UNKNOWN_LATENCY,
+                "DPAS is not supported");
+    return DPASLatency[repeatCount];
+  }
+
+private:
+  enum class OpKind : uint8_t {
+    Other,
+    Send,
+    Math,
+    Branch,
+    Intrinsic,
+    Dpas,
+    Arithmetic,
+  };
+
+  // Execution sizes above SIMD32 only show up on labels, the tables treat
+  // them as SIMD32.
+  static constexpr unsigned MAX_EXEC_SIZE = 32;
+  static constexpr unsigned MAX_DPAS_REPEAT = 8;
+
+  LatencyTable(TARGET_PLATFORM Platform, PlatformGen Gen, bool AssumeL1Hit);
+  void initLegacy();
+  void initXe();
+
+  static unsigned execSizeIndex(const G4_INST *Inst) {
+    unsigned Sz = Inst->getExecSize();
+    return Sz > MAX_EXEC_SIZE ? MAX_EXEC_SIZE : Sz;
+  }
+  // FDIV and POW take longer on pre-Xe platforms.
+  static bool isLongMath(const G4_INST *Inst) {
+    auto MathCtrl = Inst->asMathInst()->getMathCtrl();
+    return MathCtrl == MATH_FDIV || MathCtrl == MATH_POW;
+  }
+
+  uint16_t getMsgLatency(const G4_INST *Inst) const;
+
+  const TARGET_PLATFORM Platform;
+  const PlatformGen Gen;
+  const bool AssumeL1Hit;
+
+  OpKind OpKinds[G4_NUM_OPCODE];
+  uint16_t BranchLatency;
+  uint16_t IntrinsicLatency;
+  uint16_t ARFLatency;
+  uint16_t DefaultLatency;
+  // Indexed by [isLongMath][execSize].
+  uint16_t MathLatency[2][MAX_EXEC_SIZE + 1];
+  // Indexed by [dst is acc][execSize].
+  uint16_t ArithLatency[2][MAX_EXEC_SIZE + 1];
+  uint16_t DPASLatency[MAX_DPAS_REPEAT + 1];
+
+  uint16_t LabelOccupancy;
+  // Indexed by [isLongMath][isFastHFInstruction][execSize].
+  uint16_t MathOccupancy[2][2][MAX_EXEC_SIZE + 1];
+  // Occupancy of the other instructions is OpOccupancy times the number of
+  // passes for the execution size.
+  uint16_t OpOccupancy[G4_NUM_OPCODE];
+  uint16_t Passes[MAX_EXEC_SIZE + 1];
+  uint16_t FastHFPasses[MAX_EXEC_SIZE + 1];
+  uint16_t QWordPasses[MAX_EXEC_SIZE + 1];
 };
 
 } // namespace vISA
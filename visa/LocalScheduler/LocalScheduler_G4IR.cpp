@@ -34,7 +34,7 @@ void LocalScheduler::localScheduling() {
   bbInfo.reserve(fg.size());
 
   const Options *options = fg.builder->getOptions();
-  auto LT = LatencyTable::createLatencyTable(*fg.builder);
+  const LatencyTable &LT = LatencyTable::get(*fg.builder);
 
   PointsToAnalysis p(fg.getKernel()->Declares, fg.size());
   p.doPointsToAnalysis(fg);
@@ -53,7 +53,7 @@ void LocalScheduler::localScheduling() {
     if (instCountBefore < SCH_THRESHOLD) {
       unsigned int sequentialCycles = 0;
       for (G4_INST *inst : *bb)
-        sequentialCycles += LT->getOccupancy(inst);
+        sequentialCycles += LT.getOccupancy(inst);
 
       bbInfo.push_back({(int)bb->getId(), sequentialCycles, 0,
           (unsigned char)bb->getNestLevel()});
@@ -78,7 +78,7 @@ void LocalScheduler::localScheduling() {
           G4_BB *tempBB = fg.createNewBB(false);
           sections.push_back(tempBB);
           tempBB->splice(tempBB->begin(), bb, bb->begin(), inst_it);
-          G4_BB_Schedule schedule(fg.getKernel(), tempBB, *LT, p);
+          G4_BB_Schedule schedule(fg.getKernel(), tempBB, LT, p);
           sequentialCycles += schedule.sequentialCycle;
           sendStallCycles += schedule.sendStallCycle;
           count = 0;
@@ -96,7 +96,7 @@ void LocalScheduler::localScheduling() {
           (unsigned char)bb->getNestLevel()});
       totalCycles += sequentialCycles;
     } else {
-      G4_BB_Schedule schedule(fg.getKernel(), bb, *LT, p);
+      G4_BB_Schedule schedule(fg.getKernel(), bb, LT, p);
       bbInfo.push_back({(int)bb->getId(), schedule.sequentialCycle,
           schedule.sendStallCycle, (unsigned char)bb->getNestLevel()});
       totalCycles += schedule.sequentialCycle;
@@ -1797,10 +1797,46 @@ void DDD::pairTypedWriteOrURBWriteNodes(G4_BB *bb) {
   }
 }
 
+void DDD::flattenGraph() {
+  // Node IDs are not dense, since grouped instructions (DPAS macros,
+  // read-suppression groups) share one node, so each node is given its
+  // position in the flat arrays instead.
+  size_t numSuccs = 0, numPreds = 0;
+  for (auto N : allNodes) {
+    numSuccs += N->succs.size();
+    numPreds += N->preds.size();
+  }
+
+  succOffsets.clear();
+  predOffsets.clear();
+  flatSuccs.clear();
+  flatPreds.clear();
+  succOffsets.reserve(allNodes.size() + 1);
+  predOffsets.reserve(allNodes.size() + 1);
+  flatSuccs.reserve(numSuccs);
+  flatPreds.reserve(numPreds);
+  for (auto it = allNodes.rbegin(), ite = allNodes.rend(); it != ite; ++it) {
+    Node *N = *it;
+    N->flatIdx = (unsigned)succOffsets.size();
+    succOffsets.push_back((uint32_t)flatSuccs.size());
+    predOffsets.push_back((uint32_t)flatPreds.size());
+    for (const Edge &E : N->succs)
+      flatSuccs.push_back({E.getNode(), E.getLatency()});
+    for (const Edge &E : N->preds)
+      flatPreds.push_back({E.getNode(), E.getLatency()});
+    // The DAG is final, so the edge vectors aren't needed anymore.
+    EdgeVector().swap(N->succs);
+    EdgeVector().swap(N->preds);
+  }
+  succOffsets.push_back((uint32_t)flatSuccs.size());
+  predOffsets.push_back((uint32_t)flatPreds.size());
+}
+
 void DDD::collectRoots() {
+  flattenGraph();
   Roots.clear();
   for (auto N : allNodes) {
-    if (N->preds.empty() && !N->getInstructions()->empty()) {
+    if (getPreds(N).empty() && !N->getInstructions()->empty()) {
       Roots.push_back(N);
     }
   }
@@ -2142,7 +2178,7 @@ uint32_t DDD::listScheduleForSuppression(G4_BB_Schedule *schedule) {
     // Set the cycle at which this node is scheduled.
     scheduled->schedTime = currCycle;
 
-    for (auto &curSucc : scheduled->succs) {
+    for (const FlatEdge &curSucc : getSuccs(scheduled)) {
       Node *succ = curSucc.getNode();
       // Recompute the earliest time for each successor.
       if (scheduled->isLabel()) {
@@ -2206,7 +2242,7 @@ uint32_t DDD::listScheduleFor2xFP(G4_BB_Schedule *schedule) {
   auto updateForSucc = [&](Node *scheduled,
                            std::priority_queue<Node *, std::vector<Node *>,
                                                earlyCmp> *preReadyQueue) {
-    for (auto &curSucc : scheduled->succs) {
+    for (const FlatEdge &curSucc : getSuccs(scheduled)) {
       Node *succ = curSucc.getNode();
       // Recompute the earliest time for each successor.
       if (scheduled->isLabel()) {
@@ -2429,7 +2465,7 @@ uint32_t DDD::listSchedule(G4_BB_Schedule *schedule) {
   Node *lastScheduled = nullptr;
 
   auto updateForSucc = [&](Node *scheduled) {
-    for (auto &curSucc : scheduled->succs) {
+    for (const FlatEdge &curSucc : getSuccs(scheduled)) {
       Node *succ = curSucc.getNode();
       // Recompute the earliest time for each successor.
       if (scheduled->isLabel()) {
@@ -2892,11 +2928,9 @@ void DDD::DumpDotFile(G4_BB *bb) {
 
   for (iNode = allNodes.begin(); iNode != endNodes; ++iNode) {
     Node *node = *iNode;
-    EdgeVector::iterator iEdge(node->succs.begin()),
-        endEdges(node->succs.end());
-    for (; iEdge != endEdges; ++iEdge) {
+    for (const FlatEdge &E : getSuccs(node)) {
       ofile << "\tID_" << node->nodeID << " -> "
-            << "ID_" << (*iEdge).getNode()->nodeID;
+            << "ID_" << E.getNode()->nodeID;
     }
   }
   ofile << " }"
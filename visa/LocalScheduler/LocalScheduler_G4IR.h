@@ -22,6 +22,7 @@ SPDX-License-Identifier: MIT
 
 // clang-format off
 #include "common/LLVMWarningsPush.hpp"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/Support/Allocator.h"
 #include "common/LLVMWarningsPop.hpp"
 // clang-format on
@@ -63,6 +64,15 @@ public:
   void setLatency(uint32_t newLatency) { latency = newLatency; }
 };
 
+// Edge of the flattened DAG, see DDD::flattenGraph().
+struct FlatEdge {
+  Node *node;
+  uint32_t latency;
+
+  Node *getNode() const { return node; }
+  uint32_t getLatency() const { return latency; }
+};
+
 typedef std_arena_based_allocator<Edge> Edge_Allocator;
 typedef std::vector<Edge> EdgeVector;
 using NodeAlloc = llvm::SpecificBumpPtrAllocator<Node>;
@@ -71,6 +81,10 @@ class Node {
   // Unique ID of the node.
   unsigned nodeID;
 
+  // Dense index of the node in the flattened DAG, see DDD::flattenGraph().
+  // Node IDs have holes where instructions were grouped into one node.
+  unsigned flatIdx = 0;
+
   // LIR instruction pointer
   std::list<G4_INST *> instVec;
 
@@ -102,6 +116,7 @@ public:
   static const int PRIORITY_UNINIT = -1;
 
   unsigned getNodeID() const { return nodeID; };
+  unsigned getFlatIndex() const { return flatIdx; }
 
   uint32_t schedTime = 0;
 
@@ -257,7 +272,30 @@ class DDD {
   G4_Kernel *kernel;
   PointsToAnalysis &pointsToAnalysis;
 
-  // Gather all initial ready nodes.
+  // The final DAG in compressed sparse row form: the edges of the node with
+  // flat index n are flatSuccs[succOffsets[n]] .. flatSuccs[succOffsets[n + 1]], and
+  // likewise for predecessors. The per-node edge vectors are only used while
+  // the DAG is built and are released once it is flattened.
+  std::vector<uint32_t> succOffsets;
+  std::vector<FlatEdge> flatSuccs;
+  std::vector<uint32_t> predOffsets;
+  std::vector<FlatEdge> flatPreds;
+
+  // Lay out the edges of the final DAG contiguously and release the per-node
+  // edge vectors.
+  void flattenGraph();
+  llvm::ArrayRef<FlatEdge> getSuccs(const Node *node) const {
+    unsigned id = node->getFlatIndex();
+    return llvm::ArrayRef<FlatEdge>(flatSuccs.data() + succOffsets[id],
+                                    flatSuccs.data() + succOffsets[id + 1]);
+  }
+  llvm::ArrayRef<FlatEdge> getPreds(const Node *node) const {
+    unsigned id = node->getFlatIndex();
+    return llvm::ArrayRef<FlatEdge>(flatPreds.data() + predOffsets[id],
+                                    flatPreds.data() + predOffsets[id + 1]);
+  }
+
+  // Flatten the DAG and gather all initial ready nodes.
   void collectRoots();
 
 public:
@@ -365,12 +403,15 @@ private:
 
 class preRA_RegSharing {
 public:
-  preRA_RegSharing(G4_Kernel &k);
+  // With ScheduleBlocks false, only the GRF mode is selected from the
+  // current register pressure and no block is rescheduled.
+  preRA_RegSharing(G4_Kernel &k, bool ScheduleBlocks = true);
   ~preRA_RegSharing();
   bool run(unsigned &KernelPressure);
 
 private:
   G4_Kernel &kernel;
+  bool ScheduleBlocks;
 };
 // Restrictions of candidate for 2xDP:
 //    1, Only support SIMD16 DF mad with M0
@@ -8,6 +8,7 @@ SPDX-License-Identifier: MIT
 
 #include "SWSB_G4IR.h"
 #include "../G4_Opcode.h"
+#include "../ParallelFor.h"
 #include "../PointsToAnalysis.h"
 #include "../Timer.h"
 #include "Dependencies_G4IR.h"
@@ -1446,6 +1447,8 @@ void SWSB::SWSBDepDistanceGenerator(PointsToAnalysis &p, LiveGRFBuckets &LB,
     setDefaultDistanceAtFirstInstruction();
   }
 
+  computeInstFootprints(p);
+
   // Local dependence analysis
   for (; ib != bend; ++ib) {
     // TODO: Can each G4_BB_SB have its own allocator instead of sharing SWSB's?
@@ -1454,6 +1457,36 @@ void SWSB::SWSBDepDistanceGenerator(PointsToAnalysis &p, LiveGRFBuckets &LB,
                  &globalSendOpndList, &indexes, globalSendNum, &LB,
                  &globalSendsLB, p, &labelToBlockMap, tokenAfterDPASCycle);
   }
+  instFootprints.clear();
+}
+
+// The local dependence analysis has to visit the BBs in order, as the live
+// buckets and the ALU IDs are carried from one BB to the next. The operand
+// footprints only depend on the instruction though, so with -SWSBThreads they
+// are computed for all BBs concurrently beforehand.
+void SWSB::computeInstFootprints(PointsToAnalysis &p) {
+  unsigned numThreads = fg.builder->getuint32Option(vISA_SWSBThreads);
+  if (numThreads <= 1 || fg.size() < 2) {
+    return;
+  }
+
+  std::vector<G4_BB *> BBs(fg.begin(), fg.end());
+  instFootprints.resize(BBs.size());
+  Mem_Manager::ConcurrentScope scope(SWSBMem);
+  parallelFor(numThreads, BBs.size(), [&](unsigned, size_t i) {
+    G4_BB_SB footprintBB(*this, *fg.builder, SWSBMem, BBs[i]);
+    footprintBB.computeInstFootprints(p, instFootprints[BBs[i]->getId()]);
+  });
+}
+
+const SBInstFootprints *SWSB::getInstFootprints(const G4_BB *bb,
+                                                const G4_INST *inst) const {
+  if (bb->getId() >= instFootprints.size()) {
+    return nullptr;
+  }
+  const SBInstFootprintMap &IFs = instFootprints[bb->getId()];
+  auto it = IFs.find(inst);
+  return it == IFs.end() ? nullptr : &it->second;
 }
 
 void SWSB::handleFuncCall() {
@@ -5332,6 +5365,22 @@ bool G4_BB_SB::hasIndirectSource(SBNode *node) {
 }
 
 bool G4_BB_SB::getGRFFootPrint(SBNode *node, PointsToAnalysis &p) {
+  // Instructions added since the footprints were computed, e.g. the dpas WA
+  // ones, aren't found.
+  if (const SBInstFootprints *IF =
+          swsb.getInstFootprints(bb, node->GetInstruction())) {
+    for (int i = 0; i < Opnd_total_num; i++) {
+      if (IF->footprints[i]) {
+        node->setFootprint(IF->footprints[i], (Gen4_Operand_Number)i);
+      }
+    }
+    return IF->hasDistOneAReg;
+  }
+
+  return computeGRFFootPrint(node, p);
+}
+
+bool G4_BB_SB::computeGRFFootPrint(SBNode *node, PointsToAnalysis &p) {
   bool hasDistOneAReg = false;
   // We get the description for source first, so for current instruction, the
   // scan order is src0, src1, src2, src3, dst
@@ -5347,6 +5396,22 @@ bool G4_BB_SB::getGRFFootPrint(SBNode *node, PointsToAnalysis &p) {
   return hasDistOneAReg;
 }
 
+void G4_BB_SB::computeInstFootprints(PointsToAnalysis &p,
+                                     SBInstFootprintMap &IFs) {
+  IFs.reserve(bb->size());
+  for (G4_INST *inst : *bb) {
+    if (inst->isLabel()) {
+      continue;
+    }
+    SBNode node(0, 0, bb->getId(), inst);
+    SBInstFootprints &IF = IFs[inst];
+    IF.hasDistOneAReg = computeGRFFootPrint(&node, p);
+    for (int i = 0; i < Opnd_total_num; i++) {
+      IF.footprints[i] = node.getFirstFootprint((Gen4_Operand_Number)i);
+    }
+  }
+}
+
 void G4_BB_SB::getGRFBucketDescs(SBNode *node, std::vector<SBBucketDesc> &BDvec,
                                  bool GRFOnly) {
   // We get the description for source first, so for current instruction, the
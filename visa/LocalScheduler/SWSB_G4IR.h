@@ -17,6 +17,7 @@ SPDX-License-Identifier: MIT
 
 // clang-format off
 #include "common/LLVMWarningsPush.hpp"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Allocator.h"
 #include "common/LLVMWarningsPop.hpp"
 // clang-format on
@@ -624,6 +625,14 @@ typedef struct _SWSB_LOOP {
   int endBBID = -1;
 } SWSB_LOOP;
 
+// The operand footprints of an instruction, computed ahead of the local
+// dependence analysis.
+struct SBInstFootprints {
+  SBFootprint *footprints[Opnd_total_num];
+  bool hasDistOneAReg;
+};
+typedef llvm::DenseMap<const G4_INST *, SBInstFootprints> SBInstFootprintMap;
+
 class G4_BB_SB {
 private:
   const SWSB &swsb;
@@ -720,6 +729,12 @@ public:
           globalSendNum, p, LabelToBlockMap);
   }
 
+  // Only sets up what is needed to compute footprints.
+  G4_BB_SB(const SWSB &sb, IR_Builder &b, Mem_Manager &m, G4_BB *block)
+      : swsb(sb), builder(b), mem(m), bb(block), tokenAfterDPASCycle(0) {
+    totalGRFNum = block->getKernel().getNumRegTotal();
+  }
+
   ~G4_BB_SB() {}
 
   G4_BB *getBB() const { return bb; }
@@ -755,6 +770,8 @@ public:
   bool hasIndirectSource(SBNode *node);
 
   bool getGRFFootPrint(SBNode *node, PointsToAnalysis &p);
+  bool computeGRFFootPrint(SBNode *node, PointsToAnalysis &p);
+  void computeInstFootprints(PointsToAnalysis &p, SBInstFootprintMap &IFs);
 
   void getGRFBucketDescs(SBNode *node, std::vector<SBBucketDesc> &BDvec,
                          bool GRFOnly);
@@ -928,6 +945,8 @@ class SWSB {
   SWSB_INDEXES indexes;       // To pass ALU ID  from previous BB to current.
   uint32_t globalSendNum = 0; // The number of out-of-order instructions which
                               // generate global dependencies.
+  std::vector<SBInstFootprintMap>
+      instFootprints; // BB ID indexed footprints computed ahead of SBDDD
   SBBUCKET_VECTOR globalSendOpndList; // All send operands which live out their
                                       // instructions' BBs. No redundant.
   const uint32_t totalTokenNum;
@@ -1066,6 +1085,7 @@ class SWSB {
                        INST_LIST_ITER inst_it, int newInstID, BitSet *dstTokens,
                        BitSet *srcTokens, bool &keepDst, bool removeAllToken);
 
+  void computeInstFootprints(PointsToAnalysis &p);
   void SWSBDepDistanceGenerator(PointsToAnalysis &p, LiveGRFBuckets &LB,
                                 LiveGRFBuckets &globalSendsLB);
   void handleFuncCall();
@@ -1129,7 +1149,7 @@ public:
     indexes.DPASIndex = 0;
     indexes.mathIndex = 0;
     tokenAfterDPASCycle =
-        LatencyTable::createLatencyTable(*k.fg.builder)->getDPASLatency(8);
+        LatencyTable::get(*k.fg.builder).getDPASLatency(8);
   }
   ~SWSB() {}
   void SWSBGenerator();
@@ -1137,6 +1157,8 @@ public:
   // SBNodes need to be live for the entire SWSB pass but they are
   // allocated by each BB, so G4_BB_SB needs access to the allocator.
   SBNodeAlloc &getSBNodeAlloc() { return SBNodeAllocator; }
+  const SBInstFootprints *getInstFootprints(const G4_BB *bb,
+                                            const G4_INST *inst) const;
 };
 } // namespace vISA
 #endif // _SWSB_H_
@@ -11,8 +11,69 @@ SPDX-License-Identifier: MIT
 // NOTE: Object requiring dword alignment is NOT supported.
 
 #include "Mem_Manager.h"
+
+#include <algorithm>
+
 using namespace vISA;
 Mem_Manager::Mem_Manager(size_t defaultArenaSize)
     : _arenaManager(defaultArenaSize) {}
 
-Mem_Manager::~Mem_Manager() {}
+Mem_Manager::~Mem_Manager() {
+  vASSERT(_scopeId == 0);
+  for (auto &threadArena : _threadArenas) {
+    delete threadArena.second;
+  }
+}
+
+ArenaStats Mem_Manager::getStats() const {
+  ArenaStats stats = _arenaManager._stats;
+  for (auto &threadArena : _threadArenas) {
+    stats += threadArena.second->_stats;
+  }
+  return stats;
+}
+
+// Scope ids are unique across all managers, so the per-thread cache below
+// can't mistake a manager for a destroyed one that had the same address.
+static std::atomic<uint64_t> lastScopeId{0};
+
+Mem_Manager::ConcurrentScope::ConcurrentScope(Mem_Manager &m) : mem(m) {
+  vASSERT(mem._scopeId == 0 && "nested concurrent scopes are not supported");
+  mem._scopeOwner = std::this_thread::get_id();
+  mem._scopeId = ++lastScopeId;
+}
+
+Mem_Manager::ConcurrentScope::~ConcurrentScope() { mem._scopeId = 0; }
+
+ArenaManager &Mem_Manager::getThreadArenaManager() {
+  // The arena last used by this thread, valid as long as the scope it was
+  // looked up in is active.
+  static thread_local uint64_t cachedScopeId = 0;
+  static thread_local ArenaManager *cachedArena = nullptr;
+
+  uint64_t scopeId = _scopeId.load(std::memory_order_relaxed);
+  if (cachedScopeId == scopeId) {
+    return *cachedArena;
+  }
+
+  ArenaManager *arena = &_arenaManager;
+  std::thread::id self = std::this_thread::get_id();
+  if (self != _scopeOwner) {
+    std::lock_guard<std::mutex> lock(_threadArenasMutex);
+    auto it = std::find_if(_threadArenas.begin(), _threadArenas.end(),
+                           [self](const std::pair<std::thread::id,
+                                                  ArenaManager *> &entry) {
+                             return entry.first == self;
+                           });
+    if (it != _threadArenas.end()) {
+      arena = it->second;
+    } else {
+      arena = new ArenaManager(_arenaManager._defaultArenaSize);
+      _threadArenas.emplace_back(self, arena);
+    }
+  }
+
+  cachedScopeId = scopeId;
+  cachedArena = arena;
+  return *arena;
+}
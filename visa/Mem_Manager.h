@@ -14,7 +14,13 @@ SPDX-License-Identifier: MIT
 #define _MEM_MANAGER_H_
 
 #include "Arena.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace vISA {
 class Mem_Manager {
@@ -23,15 +29,46 @@ public:
   ~Mem_Manager();
 
   void *alloc(size_t size) {
-    return _arenaManager.AllocDataSpace(size, ArenaHeader::defaultAlign);
+    return getArenaManager().AllocDataSpace(size, ArenaHeader::defaultAlign);
   }
 
   void *alloc(size_t size, std::align_val_t al) {
-    return _arenaManager.AllocDataSpace(size, static_cast<size_t>(al));
+    return getArenaManager().AllocDataSpace(size, static_cast<size_t>(al));
   }
 
+  ArenaStats getStats() const;
+
+  // While a ConcurrentScope is alive, the manager may be used from several
+  // threads at once. The thread that opened the scope keeps allocating from
+  // the manager's own arenas, any other thread gets arenas of its own. The
+  // latter are owned by the manager, so what the threads allocated lives as
+  // long as the manager, and are reused by later scopes.
+  class ConcurrentScope {
+    Mem_Manager &mem;
+
+  public:
+    ConcurrentScope(Mem_Manager &m);
+    ~ConcurrentScope();
+    ConcurrentScope(const ConcurrentScope &) = delete;
+    ConcurrentScope &operator=(const ConcurrentScope &) = delete;
+  };
+
 private:
+  ArenaManager &getArenaManager() {
+    if (_scopeId.load(std::memory_order_relaxed) == 0) {
+      return _arenaManager;
+    }
+    return getThreadArenaManager();
+  }
+  ArenaManager &getThreadArenaManager();
+
   vISA::ArenaManager _arenaManager;
+
+  // Unique id of the active ConcurrentScope, 0 if there is none
+  std::atomic<uint64_t> _scopeId{0};
+  std::thread::id _scopeOwner;
+  std::mutex _threadArenasMutex;
+  std::vector<std::pair<std::thread::id, ArenaManager *>> _threadArenas;
 };
 
 template <class T> class std_arena_based_allocator {
@@ -97,6 +134,8 @@ public:
 
   size_type max_size() const { return size_t(-1); }
 
+  Mem_Manager &getMemManager() const { return *mem_manager_ptr; }
+
   bool operator==(const std_arena_based_allocator &) const { return true; }
 
   bool operator!=(const std_arena_based_allocator &a) const {
@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 #include "Timer.h"
 #include "ifcvt.h"
 #include "Common_BinaryEncoding.h"
+#include "Common_ISA_framework.h"
 #include "DebugInfo.h"
 #include "FlowGraph.h"
 #include "Passes/AccSubstitution.hpp"
@@ -26,6 +27,8 @@ SPDX-License-Identifier: MIT
 // clang-format off
 #include "common/LLVMWarningsPush.hpp"
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
 #include "common/LLVMWarningsPop.hpp"
 // clang-format on
 
@@ -33,6 +36,7 @@ SPDX-License-Identifier: MIT
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <iostream>
 #include <map>
 #include <random>
 #include <sstream>
@@ -601,9 +605,35 @@ void Optimizer::runPass(PassIndex Index) {
 
   kernel.dumpToFile("before." + Name);
 
+  auto countInsts = [this]() {
+    int64_t numInsts = 0;
+    for (auto bb : fg)
+      numInsts += bb->size();
+    return numInsts;
+  };
+  int64_t instsBefore = 0;
+  size_t arenaBytesBefore = 0;
+  std::chrono::steady_clock::time_point startTime;
+  if (CollectPassStats) {
+    instsBefore = countInsts();
+    arenaBytesBefore = mem.getStats().allocatedBytes;
+    startTime = std::chrono::steady_clock::now();
+  }
+
   // Execute pass.
   (this->*(PI.Pass))();
 
+  if (CollectPassStats) {
+    PassStats &PS = PassStat[Index];
+    PS.Seconds += std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - startTime)
+                      .count();
+    if (PS.Runs++ == 0)
+      PassRunOrder.push_back(Index);
+    PS.InstDelta += countInsts() - instsBefore;
+    PS.ArenaBytes += mem.getStats().allocatedBytes - arenaBytesBefore;
+  }
+
   if (PI.Timer != TimerID::NUM_TIMERS)
     stopTimer(PI.Timer);
 
@@ -627,6 +657,48 @@ void Optimizer::runPass(PassIndex Index) {
   setCurrentDebugPass(nullptr);
 }
 
+void Optimizer::dumpPassStats(const std::string &asmName) const {
+  if (asmName.empty())
+    return;
+  std::string jsonName = asmName + ".passes.json";
+  std::string csvName = asmName + ".passes.csv";
+  if (!CisaFramework::allowDump(*kernel.getOptions(), jsonName))
+    return;
+
+  std::ofstream json(jsonName, std::ios::out);
+  std::ofstream csv(csvName, std::ios::out);
+  if (!json || !csv) {
+    std::cerr << (json ? csvName : jsonName) << ": failed to open file\n";
+    return;
+  }
+  std::string kernelName;
+  llvm::raw_string_ostream(kernelName)
+      << llvm::json::Value(kernel.getName() ? kernel.getName() : "");
+  json << "{\n  \"kernel\": " << kernelName << ",\n"
+       << "  \"passes\": [";
+  csv << "pass,timer,runs,seconds,inst_delta,arena_bytes\n";
+
+  // Passes are listed in the order they were first run.
+  bool first = true;
+  for (PassIndex i : PassRunOrder) {
+    const PassStats &PS = PassStat[i];
+    const PassInfo &PI = Passes[i];
+    const char *timerName = PI.Timer != TimerID::NUM_TIMERS
+                                ? getTimerName(PI.Timer)
+                                : "";
+    json << (first ? "\n" : ",\n") << "    {\"pass\": \"" << PI.Name
+         << "\", \"timer\": \"" << timerName << "\", \"runs\": " << PS.Runs
+         << ", \"seconds\": " << std::setprecision(9) << PS.Seconds
+         << ", \"inst_delta\": " << PS.InstDelta
+         << ", \"arena_bytes\": " << PS.ArenaBytes << "}";
+    csv << PI.Name << "," << timerName << "," << PS.Runs << ","
+        << std::setprecision(9) << PS.Seconds << "," << PS.InstDelta << ","
+        << PS.ArenaBytes << "\n";
+    first = false;
+  }
+  json << "\n  ]\n}\n";
+}
+
 void Optimizer::initOptimizations() {
 #define OPT_INITIALIZE_PASS(Name, Option, Timer)                                   \
   Passes[PI_##Name] = PassInfo(&Optimizer::Name, "" #Name, Option, Timer)
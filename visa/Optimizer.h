@@ -153,11 +153,17 @@ class Optimizer {
   }
 
   void preRA_Schedule() {
+    // Over the compile-time budget only the scheduling is skipped; the
+    // reg-sharing heuristics still have to pick the GRF mode.
+    bool ScheduleBlocks = kernel.getCompileEffort() <
+                          G4_Kernel::CompileEffort::NoPreRASchedule;
     unsigned KernelPressure = 0;
     if (kernel.useRegSharingHeuristics()) {
-      preRA_RegSharing Sched(kernel);
+      preRA_RegSharing Sched(kernel, ScheduleBlocks);
       Sched.run(KernelPressure);
     } else {
+      if (!ScheduleBlocks)
+        return;
       preRA_Scheduler Sched(kernel);
       Sched.run(KernelPressure);
     }
@@ -331,6 +337,16 @@ private:
           Timer(TimerID::NUM_TIMERS) {}
   };
 
+  /// Cost of a pass in this kernel, collected with -dumpPassStats.
+  struct PassStats {
+    unsigned Runs = 0;
+    double Seconds = 0.0;
+    /// Change of the number of instructions in the kernel.
+    int64_t InstDelta = 0;
+    /// Bytes allocated from the kernel arena.
+    size_t ArenaBytes = 0;
+  };
+
   bool foldPseudoAndOr(G4_BB *bb, INST_LIST_ITER &iter);
 
 public:
@@ -405,6 +421,11 @@ private:
   /// Array of passes registered.
   PassInfo Passes[PI_NUM_PASSES];
 
+  /// Per pass statistics, only collected if CollectPassStats is set.
+  PassStats PassStat[PI_NUM_PASSES];
+  std::vector<PassIndex> PassRunOrder;
+  bool CollectPassStats = false;
+
   // indicates whether RA has failed
   bool RAFail;
   // Name of the pass that we should stop before/after, from the
@@ -439,6 +460,7 @@ public:
       StopAfterPass = std::string(PassName);
     }
 #endif // DLL_MODE
+    CollectPassStats = k.getOption(vISA_dumpPassStats);
     initOptimizations();
   }
   ~Optimizer() {
@@ -450,6 +472,12 @@ public:
     }
   }
   int optimization();
+
+  /// Writes the statistics collected with -dumpPassStats of the passes that
+  /// ran to <asmName>.passes.json and <asmName>.passes.csv, asmName being the
+  /// kernel's output asm path without extension. Nothing is written without
+  /// one.
+  void dumpPassStats(const std::string &asmName) const;
 };
 
 } // namespace vISA
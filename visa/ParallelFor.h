@@ -0,0 +1,127 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef _PARALLELFOR_H_
+#define _PARALLELFOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vISA {
+
+// Threads shared by all parallelFor() calls of the process. They are started
+// on first use, as many as the widest call asked for so far, and then wait for
+// more work instead of being started and joined again by every call.
+class WorkerPool {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::function<void()>> tasks;
+  std::vector<std::thread> threads;
+
+  void work() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return !tasks.empty(); });
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+public:
+  // The pool is never destroyed: its threads may still be waiting when the
+  // library is unloaded, and joining them from a static destructor can hang.
+  static WorkerPool &get() {
+    static WorkerPool *pool = new WorkerPool();
+    return *pool;
+  }
+
+  // Queues numTasks copies of task, starting threads up to that many.
+  void run(unsigned numTasks, const std::function<void()> &task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (threads.size() < numTasks) {
+      threads.emplace_back(&WorkerPool::work, this);
+      threads.back().detach();
+    }
+    for (unsigned i = 0; i < numTasks; ++i)
+      tasks.push_back(task);
+    cv.notify_all();
+  }
+};
+
+// Calls fn(worker, i) for every i in [0, numItems) using up to numWorkers
+// threads, the calling thread being worker 0. Items are handed out in
+// increasing order as workers become free, so callers that need a
+// deterministic result must keep per-worker state and combine it afterwards.
+//
+// The other workers run on WorkerPool threads. The calling thread takes items
+// too, so the call completes even when the pool is busy with other calls; pool
+// threads that get to it after all items are taken return without calling fn.
+template <typename Fn>
+void parallelFor(unsigned numWorkers, size_t numItems, Fn fn) {
+  if (numWorkers > numItems)
+    numWorkers = (unsigned)numItems;
+  if (numWorkers <= 1) {
+    for (size_t i = 0; i < numItems; ++i)
+      fn(0u, i);
+    return;
+  }
+
+  struct State {
+    std::atomic<size_t> next{0};
+    size_t numItems = 0;
+    std::function<void(unsigned, size_t)> fn;
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned nextWorker = 1;
+    unsigned active = 0;
+    bool closed = false;
+
+    void run(unsigned worker) {
+      for (size_t i = next++; i < numItems; i = next++)
+        fn(worker, i);
+    }
+  };
+  auto state = std::make_shared<State>();
+  state->numItems = numItems;
+  state->fn = std::ref(fn);
+
+  WorkerPool::get().run(numWorkers - 1, [state]() {
+    unsigned worker;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->closed)
+        return;
+      worker = state->nextWorker++;
+      ++state->active;
+    }
+    state->run(worker);
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (--state->active == 0)
+      state->cv.notify_all();
+  });
+
+  state->run(0);
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->closed = true;
+  state->cv.wait(lock, [&] { return state->active == 0; });
+}
+
+} // namespace vISA
+
+#endif // _PARALLELFOR_H_
@@ -16,10 +16,15 @@ SPDX-License-Identifier: MIT
 #include "VarSplit.h"
 
 #include <bitset>
+#include <algorithm>
 #include <climits>
 #include <cmath>
 #include <fstream>
+#include <functional>
+#include <numeric>
 #include <optional>
+#include <queue>
+#include <type_traits>
 #include <vector>
 
 using namespace vISA;
@@ -182,6 +187,7 @@ LivenessAnalysis::LivenessAnalysis(GlobalRA &g, unsigned char kind,
                                    bool verifyRA, bool forceRun)
     : selectedRF(kind), pointsToAnalysis(g.pointsToAnalysis), gra(g),
       fg(g.kernel.fg) {
+  gra.incRA.numLiveLiveness++;
   //
   // NOTE:
   // The maydef sets are simply aliases to the mayuse sets, since their uses are
@@ -240,6 +246,7 @@ LivenessAnalysis::LivenessAnalysis(GlobalRA &g, unsigned char kind,
 }
 
 LivenessAnalysis::~LivenessAnalysis() {
+  gra.incRA.numLiveLiveness--;
   //
   // if no chosen candidate for reg allocation return
   //
@@ -555,11 +562,20 @@ void LivenessAnalysis::computeLiveness() {
   //
   // compute def_out and use_in vectors for each BB
   //
+  // With incremental RA, BBs left untouched since the previous GRF RA
+  // iteration reuse gen/kill sets computed back then.
+  bool incrementalGenKill = gra.incRA.isEnabled() && livenessClass(G4_GRF) &&
+                            gra.incRA.numLiveLiveness == 1;
+  if (incrementalGenKill)
+    updateGenKillVarStates();
   for (G4_BB *bb : fg) {
     unsigned id = bb->getId();
 
-    computeGenKillandPseudoKill(bb, def_out[id], use_in[id], use_gen[id],
-                                use_kill[id]);
+    if (incrementalGenKill)
+      computeGenKillIncremental(bb);
+    else
+      computeGenKillandPseudoKill(bb, def_out[id], use_in[id], use_gen[id],
+                                  use_kill[id]);
 
     //
     // exit block: mark output parameters live
@@ -656,16 +672,13 @@ void LivenessAnalysis::computeLiveness() {
   std::vector<G4_BB *> PO;
   getPostOrder(fg.getEntryBB(), PO);
 
-  bool change;
-
   //
   // backward flow analysis to propagate uses (locate last uses)
   //
-  do {
-    change = false;
-    for (auto I = PO.begin(), E = PO.end(); I != E; ++I)
-      change |= contextFreeUseAnalyze(*I, change);
-  } while (change);
+  solveDataFlow</* Backward */ true>(
+      PO, [this](G4_BB *bb, bool isFirstVisit) {
+        return contextFreeUseAnalyze(bb, isFirstVisit);
+      });
 
   //
   // initialize entry block with payload input
@@ -675,11 +688,10 @@ void LivenessAnalysis::computeLiveness() {
   //
   // forward flow analysis to propagate defs (locate first defs)
   //
-  do {
-    change = false;
-    for (auto I = PO.rbegin(), E = PO.rend(); I != E; ++I)
-      change |= contextFreeDefAnalyze(*I, change);
-  } while (change);
+  solveDataFlow</* Backward */ false>(
+      PO, [this](G4_BB *bb, bool isFirstVisit) {
+        return contextFreeDefAnalyze(bb, isFirstVisit);
+      });
 
   //
   // dump vectors for debugging
@@ -1137,9 +1149,119 @@ void LivenessAnalysis::footprintSrc(const G4_INST *i, G4_Operand *opnd,
   opnd->updateFootPrint(*srcfootprint, false, i->getBuilder());
 }
 
+//
+// Record RA state of each variable that gen/kill sets depend on so that
+// incremental RA drops the sets it recorded for BBs referencing variables
+// whose state changed since previous GRF liveness.
+//
+void LivenessAnalysis::updateGenKillVarStates() const {
+  for (G4_Declare *dcl : gra.kernel.Declares) {
+    if (dcl->getAliasDeclare())
+      continue;
+    IncrementalRA::GenKillVarState state;
+    const G4_RegVar *var = dcl->getRegVar();
+    const LocalLiveRange *localLR = gra.getLocalLR(dcl);
+    unsigned int first = 0;
+    state.id = var->getId();
+    state.flags = (unsigned)var->isRegAllocPartaker() |
+                  (unsigned)gra.isBlockLocal(dcl) << 1 |
+                  (unsigned)dcl->getAddressed() << 2 |
+                  (unsigned)dcl->isInput() << 3 |
+                  (unsigned)doesVarNeedNoMaskForKill(dcl) << 4;
+    if (localLR && localLR->isLiveRangeLocal())
+      state.localFirstRef = localLR->getFirstRef(first);
+    auto neverDefined = neverDefinedRows.find(dcl);
+    if (neverDefined != neverDefinedRows.end())
+      state.neverDefinedRows = neverDefined->second;
+    gra.incRA.updateGenKillVarState(dcl, std::move(state));
+  }
+}
+
+//
+// Compute gen/kill sets of bb reusing the ones previous GRF liveness computed
+// when they're still valid, which is the case for BBs that spill/fill code
+// didn't touch. With incremental RA verification, the sets are recomputed
+// anyway and checked against the ones that would be reused.
+//
+void LivenessAnalysis::computeGenKillIncremental(G4_BB *bb) {
+  unsigned id = bb->getId();
+  auto *prev = gra.incRA.getGenKill(bb, selectedRF);
+  if (prev && !gra.incRA.isEnabledWithVerification()) {
+    def_out[id] = prev->def_out;
+    use_gen[id] = prev->use_gen;
+    use_kill[id] = prev->use_kill;
+    use_in[id] = use_gen[id];
+
+    // Re-insert the pseudo kills at the same places. Instructions they were
+    // inserted before are still in bb as it wasn't modified.
+    if (!prev->pseudoKills.empty()) {
+      std::unordered_map<const G4_INST *, INST_LIST_ITER> insertPos;
+      for (auto &pseudoKill : prev->pseudoKills)
+        insertPos.emplace(pseudoKill.second, bb->end());
+      for (auto it = bb->begin(), end = bb->end(); it != end; ++it) {
+        auto pos = insertPos.find(*it);
+        if (pos != insertPos.end())
+          pos->second = it;
+      }
+      for (auto &pseudoKill : prev->pseudoKills) {
+        G4_INST *killInst = fg.builder->createPseudoKill(
+            pseudoKill.first, PseudoKillType::FromLiveness, false);
+        bb->insertBefore(insertPos[pseudoKill.second], killInst);
+      }
+    }
+    return;
+  }
+
+  // Sets of a BB ending with fcall or with indirect accesses that depend on
+  // points-to analysis can't be reused.
+  std::vector<const G4_Declare *> refs;
+  bool reusable = !bb->isEndWithFCall();
+  auto addRef = [&](G4_Operand *opnd) {
+    if (!opnd)
+      return;
+    if (opnd->isIndirect() || opnd->isAddrExp()) {
+      reusable = false;
+      return;
+    }
+    G4_VarBase *base = opnd->getBase();
+    if (base && base->isRegVar())
+      refs.push_back(base->asRegVar()->getDeclare()->getRootDeclare());
+  };
+  for (auto it = bb->begin(), end = bb->end(); reusable && it != end; ++it) {
+    G4_INST *inst = *it;
+    addRef(inst->getDst());
+    addRef(inst->getPredicate());
+    addRef(inst->getCondMod());
+    for (unsigned j = 0, numSrc = inst->getNumSrc(); j < numSrc; j++)
+      addRef(inst->getSrc(j));
+  }
+
+  IncrementalRA::BBGenKill genKill;
+  computeGenKillandPseudoKill(bb, def_out[id], use_in[id], use_gen[id],
+                              use_kill[id], &genKill.pseudoKills);
+  vISA_ASSERT(!prev || (prev->def_out == def_out[id] &&
+                        prev->use_gen == use_gen[id] &&
+                        prev->use_kill == use_kill[id] &&
+                        prev->pseudoKills == genKill.pseudoKills),
+              "stale gen/kill sets reused by incremental RA");
+  if (!reusable) {
+    gra.incRA.markBBModified(bb);
+    return;
+  }
+
+  std::sort(refs.begin(), refs.end());
+  refs.erase(std::unique(refs.begin(), refs.end()), refs.end());
+  genKill.RF = selectedRF;
+  genKill.def_out = def_out[id];
+  genKill.use_gen = use_gen[id];
+  genKill.use_kill = use_kill[id];
+  gra.incRA.recordGenKill(bb, std::move(genKill), refs);
+}
+
 void LivenessAnalysis::computeGenKillandPseudoKill(
     G4_BB *bb, llvm_SBitVector &def_out, llvm_SBitVector &use_in,
-    llvm_SBitVector &use_gen, llvm_SBitVector &use_kill) const {
+    llvm_SBitVector &use_gen, llvm_SBitVector &use_kill,
+    std::vector<std::pair<G4_Declare *, G4_INST *>> *insertedKills) const {
   //
   // Mark each fcall as using all globals and arg pre-defined var
   //
@@ -1554,6 +1676,8 @@ void LivenessAnalysis::computeGenKillandPseudoKill(
     G4_INST *killInst = fg.builder->createPseudoKill(
         pseudoKill.first, PseudoKillType::FromLiveness, false);
     bb->insertBefore(iterToInsert, killInst);
+    if (insertedKills)
+      insertedKills->emplace_back(pseudoKill.first, *iterToInsert);
   }
   for (auto pseudoKill : pseudoKillsForSpills) {
     INST_LIST_ITER iterToInsert = pseudoKill.second.base();
@@ -1563,6 +1687,8 @@ void LivenessAnalysis::computeGenKillandPseudoKill(
     G4_INST *killInst = fg.builder->createPseudoKill(
         pseudoKill.first, PseudoKillType::FromLiveness, false);
     bb->insertBefore(iterToInsert, killInst);
+    if (insertedKills)
+      insertedKills->emplace_back(pseudoKill.first, *iterToInsert);
   }
 
   //
@@ -1572,69 +1698,116 @@ void LivenessAnalysis::computeGenKillandPseudoKill(
 }
 
 //
-// use_out = use_in(s1) + use_in(s2) + ... where s1 s2 ... are the successors of
-// bb use_in  = use_gen + (use_out - use_kill)
+// Solve a data flow problem over the BBs in PO with a worklist. Every BB is
+// visited once in PO for a backward problem, or in RPO for a forward one, and
+// after that only when transfer() reported a change for one of its successors
+// (backward) or predecessors (forward). Pending BBs are always taken in that
+// same order, so loops converge without sweeping over the whole CFG again.
+// BBs not reachable from the entry are left alone.
 //
-bool LivenessAnalysis::contextFreeUseAnalyze(G4_BB *bb, bool isChanged) {
-  bool changed;
+template <bool Backward, typename TransferFn>
+void LivenessAnalysis::solveDataFlow(const std::vector<G4_BB *> &PO,
+                                     TransferFn transfer) {
+  if (fg.builder->getOption(vISA_LivenessFullSweep)) {
+    // Recompute every BB from scratch until a whole sweep changes nothing.
+    bool changed;
+    do {
+      changed = false;
+      for (size_t n = 0, e = PO.size(); n != e; ++n)
+        changed |= transfer(PO[Backward ? n : e - 1 - n], true);
+    } while (changed);
+    return;
+  }
 
-  unsigned bbid = bb->getId();
+  std::vector<unsigned> POIndex(numBBId, UINT_MAX);
+  for (unsigned i = 0, e = (unsigned)PO.size(); i != e; ++i) {
+    POIndex[PO[i]->getId()] = i;
+  }
 
-  if (bb->Succs.empty()) // exit block
-  {
-    changed = false;
-  } else if (isChanged) {
-    // no need to update changed. This saves a memcpy
-    for (auto succBB : bb->Succs) {
-      use_out[bbid] |= use_in[succBB->getId()];
+  // Min-heap on the PO index for backward problems, max-heap otherwise.
+  using Compare = std::conditional_t<Backward, std::greater<unsigned>,
+                                     std::less<unsigned>>;
+  std::vector<unsigned> initial(PO.size());
+  std::iota(initial.begin(), initial.end(), 0);
+  std::priority_queue<unsigned, std::vector<unsigned>, Compare> worklist(
+      Compare(), std::move(initial));
+  std::vector<bool> pending(PO.size(), true);
+  std::vector<bool> visited(PO.size(), false);
+
+  while (!worklist.empty()) {
+    unsigned i = worklist.top();
+    worklist.pop();
+    pending[i] = false;
+
+    G4_BB *bb = PO[i];
+    bool changed = transfer(bb, !visited[i]);
+    visited[i] = true;
+    if (!changed) {
+      continue;
     }
-    changed = true;
-  } else {
-    llvm_SBitVector old = use_out[bbid];
-    for (auto succBB : bb->Succs) {
-      use_out[bbid] |= use_in[succBB->getId()];
+
+    for (auto depBB : Backward ? bb->Preds : bb->Succs) {
+      unsigned j = POIndex[depBB->getId()];
+      if (j != UINT_MAX && !pending[j]) {
+        pending[j] = true;
+        worklist.push(j);
+      }
     }
+  }
+}
 
-    changed = (old != use_out[bbid]);
+//
+// use_out = use_in(s1) + use_in(s2) + ... where s1 s2 ... are the successors of
+// bb use_in  = use_gen + (use_out - use_kill)
+// Returns true if use_in changed.
+//
+bool LivenessAnalysis::contextFreeUseAnalyze(G4_BB *bb, bool isFirstVisit) {
+  unsigned bbid = bb->getId();
+
+  // |= reports whether any bit was added, which saves copying use_out to
+  // find out.
+  bool outChanged = isFirstVisit;
+  for (auto succBB : bb->Succs) {
+    outChanged |= (use_out[bbid] |= use_in[succBB->getId()]);
+  }
+  if (!outChanged) {
+    return false;
   }
 
   //
   // in = gen + (out - kill)
   //
-  use_in[bbid] = use_out[bbid];
-  use_in[bbid] = use_in[bbid] - use_kill[bbid];
-  use_in[bbid] |= use_gen[bbid];
-
-  return changed;
+  llvm_SBitVector in = use_out[bbid] - use_kill[bbid];
+  in |= use_gen[bbid];
+
+  if (isFirstVisit) {
+    // use_in still holds its initial value which may not be a subset of the
+    // new one.
+    bool changed = (in != use_in[bbid]);
+    use_in[bbid] = std::move(in);
+    return changed;
+  }
+  // use_out only grows, and so does use_in.
+  return use_in[bbid] |= in;
 }
 
 //
 // def_in = def_out(p1) + def_out(p2) + ... where p1 p2 ... are the predecessors
 // of bb def_out |= def_in
+// Returns true if def_out changed.
 //
-bool LivenessAnalysis::contextFreeDefAnalyze(G4_BB *bb, bool isChanged) {
-  bool changed = false;
+bool LivenessAnalysis::contextFreeDefAnalyze(G4_BB *bb, bool isFirstVisit) {
   unsigned bbid = bb->getId();
 
-  if (bb->Preds.empty()) {
-    changed = false;
-  } else if (isChanged) {
-    // no need to update changed. This saves a memcpy
-    for (auto predBB : bb->Preds) {
-      def_in[bbid] |= def_out[predBB->getId()];
-    }
-    changed = true;
-  } else {
-    llvm_SBitVector old = def_in[bbid];
-    for (auto predBB : bb->Preds) {
-      def_in[bbid] |= def_out[predBB->getId()];
-    }
-    changed = (old != def_in[bbid]);
+  bool inChanged = isFirstVisit;
+  for (auto predBB : bb->Preds) {
+    inChanged |= (def_in[bbid] |= def_out[predBB->getId()]);
+  }
+  if (!inChanged) {
+    return false;
   }
 
-  def_out[bb->getId()] |= def_in[bb->getId()];
-
-  return changed;
+  return def_out[bbid] |= def_in[bbid];
 }
 
 void LivenessAnalysis::dump_bb_vector(char *vname, std::vector<BitSet> &vec) {
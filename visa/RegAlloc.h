@@ -69,12 +69,18 @@ class LivenessAnalysis {
   std::unordered_map<G4_Declare *, BitSet> neverDefinedRows;
   std::unordered_set<const G4_Declare *> defWriteEnable;
 
-  void computeGenKillandPseudoKill(G4_BB *bb, llvm_SBitVector &def_out,
-                                   llvm_SBitVector &use_in, llvm_SBitVector &use_gen,
-                                   llvm_SBitVector &use_kill) const;
-
-  bool contextFreeUseAnalyze(G4_BB *bb, bool isChanged);
-  bool contextFreeDefAnalyze(G4_BB *bb, bool isChanged);
+  void computeGenKillandPseudoKill(
+      G4_BB *bb, llvm_SBitVector &def_out, llvm_SBitVector &use_in,
+      llvm_SBitVector &use_gen, llvm_SBitVector &use_kill,
+      std::vector<std::pair<G4_Declare *, G4_INST *>> *insertedKills =
+          nullptr) const;
+  void updateGenKillVarStates() const;
+  void computeGenKillIncremental(G4_BB *bb);
+
+  bool contextFreeUseAnalyze(G4_BB *bb, bool isFirstVisit);
+  bool contextFreeDefAnalyze(G4_BB *bb, bool isFirstVisit);
+  template <bool Backward, typename TransferFn>
+  void solveDataFlow(const std::vector<G4_BB *> &PO, TransferFn transfer);
 
   bool livenessCandidate(const G4_Declare *decl, bool verifyRA) const;
 
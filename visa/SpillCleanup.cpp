@@ -135,6 +135,7 @@ void CoalesceSpillFills::copyToOldFills(
       G4_INST *copy = kernel.fg.builder->createMov(simdSize, movDst, src,
                                                    InstOpt_WriteEnable, false);
 
+      gra.incRA.markBBModified(bb);
       bb->insertBefore(f, copy);
 
       if (gra.EUFusionNoMaskWANeeded()) {
@@ -224,6 +225,7 @@ void CoalesceSpillFills::coalesceSpills(
     bb->erase(spill);
   }
   coalesceableSpills.clear();
+  gra.incRA.markBBModified(bb);
   bb->insertBefore(f, coalescedSpillSrc->getInst());
 }
 
@@ -297,6 +299,7 @@ void CoalesceSpillFills::coalesceFills(
   }
 
   coalesceableFills.clear();
+  gra.incRA.markBBModified(bb);
   bb->insertBefore(f, newFill);
 }
 
@@ -1036,6 +1039,7 @@ void CoalesceSpillFills::fills() {
 
       if (inst->isPseudoKill() &&
           replaceMap.find(inst->getDst()->getTopDcl()) != replaceMap.end()) {
+        gra.incRA.markBBModified(bb);
         instIt = bb->erase(instIt);
         continue;
       }
@@ -1143,6 +1147,7 @@ void CoalesceSpillFills::spills() {
                                                 ->getTopDcl());
                 // Delete earlier spill since its made redundant
                 // by current spill.
+                gra.incRA.markBBModified(bb);
                 bb->erase(*coalIt);
               }
 
@@ -1233,6 +1238,7 @@ void CoalesceSpillFills::spills() {
 
       if (inst->isPseudoKill() &&
           replaceMap.find(inst->getDst()->getTopDcl()) != replaceMap.end()) {
+        gra.incRA.markBBModified(bb);
         instIt = bb->erase(instIt);
         continue;
       }
@@ -1303,6 +1309,7 @@ void CoalesceSpillFills::fixSendsSrcOverlap() {
                 copyDcl->getRegVar(), row, 0, 1, Type_UD);
             G4_INST *copyInst = kernel.fg.builder->createMov(
                 g4::SIMD8, dstRgn, srcRgn, InstOpt_WriteEnable, false);
+            gra.incRA.markBBModified(bb);
             bb->insertBefore(instIt, copyInst);
 
             if (gra.EUFusionNoMaskWANeeded()) {
@@ -1555,6 +1562,7 @@ void CoalesceSpillFills::removeRedundantSplitMovs() {
       for (auto m : allMovs) {
         auto bb = m.first;
         auto iter = m.second;
+        gra.incRA.markBBModified(bb);
         bb->erase(iter);
       }
     }
@@ -1768,6 +1776,7 @@ void CoalesceSpillFills::spillFillCleanup() {
               execSize, nDst, nSrc, InstOpt_WriteEnable, false);
           gra.incRA.markForIntfUpdate(nDst->getTopDcl());
           gra.incRA.markForIntfUpdate(nSrc->getTopDcl());
+          gra.incRA.markBBModified(bb);
           bb->insertBefore(instIt, mov);
 
           if (gra.EUFusionNoMaskWANeeded()) {
@@ -1779,6 +1788,7 @@ void CoalesceSpillFills::spillFillCleanup() {
 
         auto tempIt = instIt;
         tempIt--;
+        gra.incRA.markBBModified(bb);
         bb->erase(instIt);
         instIt = tempIt;
       }
@@ -1831,8 +1841,10 @@ void CoalesceSpillFills::removeRedundantWrites() {
           }
 
           if (allRowsFound) {
-            if (!isGRFAssigned(inst->getDst()))
+            if (!isGRFAssigned(inst->getDst())) {
+              gra.incRA.markBBModified(bb);
               instIt = bb->erase(instIt);
+            }
           } else {
             unsigned int emask = inst->getOption();
             for (unsigned int k = offset; k != (offset + size); k++) {
@@ -1946,6 +1958,7 @@ void CoalesceSpillFills::removeRedundantWrites() {
       else if (inst->isFillIntrinsic())
         gra.incRA.markForIntfUpdate(
             inst->asFillIntrinsic()->getDst()->getTopDcl());
+      gra.incRA.markBBModified(bb);
       bb->erase(removeSp.second.first);
     }
   }
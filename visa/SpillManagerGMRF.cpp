@@ -3635,8 +3635,10 @@ void SpillManagerGRF::insertAddrTakenSpillAndFillCode(
     }
   }
 
-  if (BBhasSpillCode)
+  if (BBhasSpillCode) {
     gra.addSpillCodeInBB(bb);
+    gra.incRA.markBBModified(bb);
+  }
 }
 
 // Insert spill and fill code for indirect GRF accesses
@@ -4163,6 +4165,7 @@ bool SpillManagerGRF::insertSpillFillCode(G4_Kernel *kernel,
     bbId_ = (*it)->getId();
     INST_LIST::iterator jt = (*it)->begin();
     bool BBhasSpillCode = false;
+    bool BBModified = false;
 
     while (jt != (*it)->end()) {
       INST_LIST::iterator kt = jt;
@@ -4198,6 +4201,7 @@ bool SpillManagerGRF::insertSpillFillCode(G4_Kernel *kernel,
           if (getRFType(regVar) == G4_GRF) {
             if (inst->isPseudoKill()) {
               (*it)->erase(jt);
+              BBModified = true;
               jt = kt;
               continue;
             }
@@ -4222,6 +4226,7 @@ bool SpillManagerGRF::insertSpillFillCode(G4_Kernel *kernel,
           if (regVar && shouldSpillRegister(regVar)) {
             if (inst->isLifeTimeEnd()) {
               (*it)->erase(jt);
+              BBModified = true;
               break;
             }
             bool mayExceedTwoGRF = (inst->isSend() && i == 0) ||
@@ -4272,6 +4277,7 @@ bool SpillManagerGRF::insertSpillFillCode(G4_Kernel *kernel,
 
       if (failSafeSpill_ && builder_->getOption(vISA_NewFailSafeRA)) {
         context.insertPushPop(gra.useLscForSpillFill);
+        BBModified = true;
       }
 
       jt = kt;
@@ -4279,6 +4285,8 @@ bool SpillManagerGRF::insertSpillFillCode(G4_Kernel *kernel,
 
     if (BBhasSpillCode)
       gra.addSpillCodeInBB(*it);
+    if (BBhasSpillCode || BBModified)
+      gra.incRA.markBBModified(*it);
   }
 
   bbId_ = UINT_MAX;
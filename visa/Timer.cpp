@@ -9,6 +9,7 @@ SPDX-License-Identifier: MIT
 #include "Timer.h"
 #include "Assertions.h"
 #include "Option.h"
+#include "TraceEvents.h"
 
 #include <fstream>
 #include <iostream>
@@ -109,9 +110,22 @@ struct Timer {
 
 } // namespace vISA
 
-static vISA::Timer timers[static_cast<int>(TimerID::NUM_TIMERS)];
-static LARGE_INTEGER proc_freq;
-static int numTimers = static_cast<int>(TimerID::NUM_TIMERS);
+// Timers are kept per thread so that builders compiling on different threads
+// do not race on them. The values read through getTimerTicks() and friends are
+// those of the calling thread.
+static thread_local vISA::Timer timers[static_cast<int>(TimerID::NUM_TIMERS)];
+static thread_local int numTimers = static_cast<int>(TimerID::NUM_TIMERS);
+
+#ifdef MEASURE_COMPILATION_TIME
+static LONGLONG getProcFreq() {
+  static const LONGLONG freq = []() {
+    LARGE_INTEGER f;
+    QueryPerformanceFrequency(&f);
+    return f.QuadPart;
+  }();
+  return freq;
+}
+#endif
 
 void initTimer() {
 
@@ -126,7 +140,6 @@ void initTimer() {
     timers[i].hits = 0;
     createNewTimer(timerNames[i]);
   }
-  QueryPerformanceFrequency(&proc_freq);
 #endif
 }
 
@@ -155,6 +168,9 @@ int createNewTimer(const char *name) {
 
 void startTimer(TimerID timerId) {
   int timer = static_cast<int>(timerId);
+  if (vISA::traceEventsEnabled() &&
+      timer < static_cast<int>(TimerID::NUM_TIMERS))
+    vISA::beginTraceEvent(timerNames[timer], "vISA");
 #ifdef MEASURE_COMPILATION_TIME
   if (timer < static_cast<int>(TimerID::NUM_TIMERS)) {
 #if defined(_DEBUG) && defined(CHECK_TIMER)
@@ -180,14 +196,39 @@ void startTimer(TimerID timerId) {
 #endif
 }
 
+int64_t getTimerStart(TimerID timerId) {
+#ifdef MEASURE_COMPILATION_TIME
+  return timers[static_cast<int>(timerId)].currentStart;
+#else
+  return 0;
+#endif
+}
+
+void resumeTimer(TimerID timerId, int64_t start) {
+#ifdef MEASURE_COMPILATION_TIME
+  int timer = static_cast<int>(timerId);
+  if (timers[timer].currentStart != 0 || start == 0)
+    return;
+  timers[timer].currentStart = start;
+  timers[timer].hits++;
+#if defined(_DEBUG) && defined(CHECK_TIMER)
+  timers[timer].started = true;
+#endif
+#endif
+}
+
 void stopTimer(TimerID timerId) {
   int timer = static_cast<int>(timerId);
 #ifdef MEASURE_COMPILATION_TIME
   if (timer < static_cast<int>(TimerID::NUM_TIMERS)) {
+    // Not running on this thread; a timer started on another thread must be
+    // handed over with resumeTimer() first.
+    if (timers[timer].currentStart == 0)
+      return;
     LARGE_INTEGER stop;
     QueryPerformanceCounter(&stop);
     timers[timer].time += (stop.QuadPart - timers[timer].currentStart) /
-                          (double)proc_freq.QuadPart;
+                          (double)getProcFreq();
     timers[timer].ticks += (stop.QuadPart - timers[timer].currentStart);
     timers[timer].currentStart = 0;
 #if defined(_DEBUG) && defined(CHECK_TIMER)
@@ -200,6 +241,10 @@ void stopTimer(TimerID timerId) {
 #endif
   }
 #endif
+  // Only timers that were running on this thread end their span.
+  if (vISA::traceEventsEnabled() &&
+      timer < static_cast<int>(TimerID::NUM_TIMERS))
+    vISA::endTraceEvent(timerNames[timer]);
 }
 
 extern "C" unsigned int getTotalTimers() { return numTimers; }
@@ -212,6 +257,10 @@ extern "C" unsigned int getTimerHits(unsigned int idx) {
   return timers[idx].hits;
 }
 
+const char *getTimerName(TimerID timer) {
+  return timerNames[static_cast<int>(timer)];
+}
+
 // static double getTimerUS(unsigned int idx)
 // {
 //     return (timers[idx].ticks * 1000000) / (double)proc_freq.QuadPart;
@@ -17,6 +17,8 @@ SPDX-License-Identifier: MIT
 
 #include "Option.h"
 
+#include <cstdint>
+
 // Timer library for the compiler
 // To collect compile time information, do the following:
 //
@@ -41,9 +43,15 @@ int createNewTimer(const char *timerName);
 void initTimer();
 void startTimer(TimerID timer);
 void stopTimer(TimerID timer);
+const char *getTimerName(TimerID timer);
 void dumpAllTimers(const char *asmFileName, bool outputTime = false);
 void dumpEncoderStats(Options *opt, std::string &asmName);
 void resetPerKernel();
+// A timer that is started on one thread and stopped on another, like TOTAL
+// when a builder is compiled on a thread pool, is handed over with these:
+// getTimerStart() on the starting thread, resumeTimer() on the other one.
+int64_t getTimerStart(TimerID timer);
+void resumeTimer(TimerID timer, int64_t start);
 // double getTimerUS(unsigned idx);
 
 struct TimerScope {
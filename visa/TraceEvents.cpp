@@ -0,0 +1,140 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "TraceEvents.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+  std::string name;
+  const char *category;
+  unsigned tid;
+  int64_t startUs;
+  int64_t durationUs;
+};
+
+struct OpenSpan {
+  std::string name;
+  const char *category;
+  int64_t startUs;
+};
+
+std::atomic<bool> enabled{false};
+std::mutex eventsMutex;
+std::string outputFile;
+// Spans ended since the last vISAWriteTraceEvents()
+std::vector<TraceEvent> events;
+bool outputStarted = false;
+std::chrono::steady_clock::time_point epoch;
+
+// Small ids, in the order the threads first record a span, read better in
+// the viewer than std::thread::id hashes.
+std::atomic<unsigned> lastThreadId{0};
+thread_local unsigned threadId = 0;
+thread_local std::vector<OpenSpan> openSpans;
+
+int64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+}
+
+void writeJSONString(std::ostream &os, const std::string &str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if ((unsigned char)c < 0x20)
+      os << ' ';
+    else
+      os << c;
+  }
+  os << '"';
+}
+
+} // namespace
+
+namespace vISA {
+
+bool traceEventsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+void beginTraceEvent(const char *name, const char *category) {
+  if (!traceEventsEnabled())
+    return;
+  if (threadId == 0)
+    threadId = ++lastThreadId;
+  openSpans.push_back({name, category, nowUs()});
+}
+
+void endTraceEvent(const char *name) {
+  if (!traceEventsEnabled())
+    return;
+  for (auto it = openSpans.rbegin(); it != openSpans.rend(); ++it) {
+    if (it->name != name)
+      continue;
+    TraceEvent event = {std::move(it->name), it->category, threadId,
+                        it->startUs, nowUs() - it->startUs};
+    openSpans.erase(std::next(it).base());
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    events.push_back(std::move(event));
+    return;
+  }
+}
+
+} // namespace vISA
+
+extern "C" void vISAEnableTraceEvents(const char *fileName) {
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  if (enabled)
+    return;
+  outputFile = fileName;
+  epoch = std::chrono::steady_clock::now();
+  enabled = true;
+}
+
+extern "C" bool vISATraceEventsEnabled() { return vISA::traceEventsEnabled(); }
+
+extern "C" void vISABeginTraceEvent(const char *name, const char *category) {
+  vISA::beginTraceEvent(name, category);
+}
+
+extern "C" void vISAEndTraceEvent(const char *name) {
+  vISA::endTraceEvent(name);
+}
+
+extern "C" void vISAWriteTraceEvents() {
+  if (!vISA::traceEventsEnabled())
+    return;
+  // The file is written in the JSON array form of the format, whose closing
+  // bracket is optional, so each call only appends the spans it has not
+  // written yet and the file is a complete trace after every call.
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  std::ofstream os(outputFile, outputStarted ? std::ios::out | std::ios::app
+                                             : std::ios::out | std::ios::trunc);
+  if (!outputStarted)
+    os << "[";
+  for (const TraceEvent &event : events) {
+    os << (outputStarted ? ",\n" : "\n") << "{\"name\": ";
+    writeJSONString(os, event.name);
+    os << ", \"cat\": \"" << event.category
+       << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.tid
+       << ", \"ts\": " << event.startUs << ", \"dur\": " << event.durationUs
+       << "}";
+    outputStarted = true;
+  }
+  events.clear();
+}
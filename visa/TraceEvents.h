@@ -0,0 +1,27 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef _TRACEEVENTS_H_
+#define _TRACEEVENTS_H_
+
+// Process-wide timeline of compile-time spans, written in the Chrome
+// trace-event JSON format (chrome://tracing, Perfetto). Clients enable it
+// and add their own spans through the vISA*TraceEvent* functions of
+// visaBuilder_interface.h, vISA adds a span for every run of its timers.
+//
+// Spans are recorded with the thread they ran on and need not nest, a span
+// ends at the last begun open span of the same name on that thread. The
+// category must be a string literal.
+
+namespace vISA {
+bool traceEventsEnabled();
+void beginTraceEvent(const char *name, const char *category);
+void endTraceEvent(const char *name);
+} // namespace vISA
+
+#endif // _TRACEEVENTS_H_
@@ -1208,6 +1208,14 @@ public:
     return m_CISABuilder->getBuilderMode() == vISA_ASM_WRITER;
   }
 
+  // Whether variables created through the builder API must be indexed by
+  // name, so that inline asm later parsed into this kernel can refer to them.
+  // Variables created by the parser are indexed as in regular parse mode.
+  bool isInlineAsmMergeTarget() const {
+    return m_options->getOption(vISA_MergeInlineAsm) &&
+           !m_options->getOption(vISA_isParseMode);
+  }
+
   typedef CISA_IR_Builder::KernelListTy KernelListTy;
   void computeAndEmitDebugInfo(KernelListTy &functions);
 
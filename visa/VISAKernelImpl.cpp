@@ -229,7 +229,10 @@ int VISAKernelImpl::compileTillOptimize() {
 
   Optimizer optimizer(*m_kernelMem, *m_builder, *m_kernel, m_kernel->fg);
 
-  return optimizer.optimization();
+  int status = optimizer.optimization();
+  if (m_options->getOption(vISA_dumpPassStats))
+    optimizer.dumpPassStats(m_asmName);
+  return status;
 }
 
 void VISAKernelImpl::adjustIndirectCallOffset() {
@@ -753,7 +756,8 @@ int VISAKernelImpl::CISABuildPreDefinedDecls() {
         std::string varName(getPredefinedVarString(predefId));
         std::string alias = "V" + std::to_string(i);
         decl->genVar.name_index = addStringPool(varName);
-        if (m_options->getOption(vISA_isParseMode)) {
+        if (m_options->getOption(vISA_isParseMode) ||
+            m_options->getOption(vISA_MergeInlineAsm)) {
           setNameIndexMap(alias, decl, true);
           setNameIndexMap(varName, decl, true);
         }
@@ -895,8 +899,10 @@ void VISAKernelImpl::ensureVariableNameUnique(const char *&varName) {
 // Return true if varName is updated to be an unique one.
 bool VISAKernelImpl::generateVariableName(Common_ISA_Var_Class Ty,
                                           const char *&varName) {
-  if (!m_options->getOption(vISA_GenerateISAASM) && !IsAsmWriterMode()) {
+  if (!m_options->getOption(vISA_GenerateISAASM) && !IsAsmWriterMode() &&
+      !m_options->getOption(vISA_MergeInlineAsm)) {
     // variable name is a don't care if we are not outputting vISA assembly
+    // nor parsing inline asm referring to it
     return false;
   }
 
@@ -991,7 +997,7 @@ int VISAKernelImpl::CreateVISAGenVar(VISA_GenVar *&decl, const char *varName,
 
   bool nameModified = generateVariableName(decl->type, varName);
 
-  if (m_options->getOption(vISA_isParseMode) &&
+  if ((m_options->getOption(vISA_isParseMode) || isInlineAsmMergeTarget()) &&
       !setNameIndexMap(varName, decl)) {
     vISA_ASSERT_INPUT(false, "incorrect parse option");
     return VISA_FAILURE;
@@ -1086,6 +1092,12 @@ int VISAKernelImpl::CreateVISAAddrVar(VISA_AddrVar *&decl, const char *varName,
   addr_info_t *addr = &decl->addrVar;
   bool nameModified = generateVariableName(decl->type, varName);
 
+  if (isInlineAsmMergeTarget() &&
+      !setNameIndexMap(std::string(varName), decl)) {
+    vASSERT(false);
+    return VISA_FAILURE;
+  }
+
   m_GenVarToNameMap[decl] = varName;
 
   decl->index = m_addr_info_count++;
@@ -1138,6 +1150,12 @@ int VISAKernelImpl::CreateVISAPredVar(VISA_PredVar *&decl, const char *varName,
   }
   bool nameModified = generateVariableName(decl->type, varName);
 
+  if (isInlineAsmMergeTarget() &&
+      !setNameIndexMap(std::string(varName), decl)) {
+    vASSERT(false);
+    return VISA_FAILURE;
+  }
+
   m_GenVarToNameMap[decl] = varName;
 
   pred_info_t *pred = &decl->predVar;
@@ -1186,6 +1204,12 @@ int VISAKernelImpl::CreateStateVar(CISA_GEN_VAR *&decl,
   }
   bool nameModified = generateVariableName(decl->type, varName);
 
+  if (isInlineAsmMergeTarget() &&
+      !setNameIndexMap(std::string(varName), decl)) {
+    vASSERT(false);
+    return VISA_FAILURE;
+  }
+
   m_GenVarToNameMap[decl] = varName;
 
   state_info_t *state = &decl->stateVar;
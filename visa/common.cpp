@@ -11,7 +11,9 @@ SPDX-License-Identifier: MIT
 #include "IGC/common/StringMacros.hpp"
 #include "PlatformInfo.h"
 #include "visa_igc_common_header.h"
+#include <algorithm>
 #include <cctype>
+#include <mutex>
 #include <vector>
 
 using namespace vISA;
@@ -124,23 +126,32 @@ int PlatformInfo::getGenxPlatformEncoding(TARGET_PLATFORM platform) {
 
 #if !defined(NDEBUG) && !defined(DLL_MODE)
 namespace vISA {
-bool DebugFlag = false;
-bool DebugAllFlag = false;
-
-// This should set by each pass via setCurrentDebugPass()
-static const char *CurrentDebugPass = nullptr;
-// This is set when processing the vISA "-debug-only" option.
+std::atomic<bool> DebugFlag = false;
+std::atomic<bool> DebugAllFlag = false;
+
+// This should set by each pass via setCurrentDebugPass(). Each thread
+// compiles its own kernel, so each has its own current pass.
+static thread_local const char *CurrentDebugPass = nullptr;
+// This is set when processing the vISA "-debug-only" option, which may
+// happen for one kernel while another is being compiled.
 static std::vector<std::string> PassesToDebug;
+static std::mutex PassesToDebugMutex;
 
 void setCurrentDebugPass(const char *Name) { CurrentDebugPass = Name; }
 
-void addPassToDebug(std::string Name) { PassesToDebug.push_back(Name); }
+void addPassToDebug(std::string Name) {
+  std::lock_guard<std::mutex> Lock(PassesToDebugMutex);
+  if (std::find(PassesToDebug.begin(), PassesToDebug.end(), Name) ==
+      PassesToDebug.end())
+    PassesToDebug.push_back(Name);
+}
 
 bool isCurrentDebugPass() {
   if (DebugAllFlag)
     return true;
   if (!CurrentDebugPass)
     return false;
+  std::lock_guard<std::mutex> Lock(PassesToDebugMutex);
   for (auto &pass : PassesToDebug) {
     if (pass.compare(CurrentDebugPass) == 0)
       return true;
@@ -8,6 +8,7 @@ SPDX-License-Identifier: MIT
 
 #ifndef _COMMON_H_
 #define _COMMON_H_
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <sstream>
@@ -95,11 +96,11 @@ namespace vISA {
 
 // This boolean is set to true if the '-debug-only' command line option
 // is specified.
-extern bool DebugFlag;
+extern std::atomic<bool> DebugFlag;
 
 // This boolean is set to true if the '-debug-only=all' command line option
 // is specified.
-extern bool DebugAllFlag;
+extern std::atomic<bool> DebugAllFlag;
 
 // Add a pass that should emit debug information
 // This should only be called once when processing "-debug-only" option.
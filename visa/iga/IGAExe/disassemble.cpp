@@ -21,6 +21,8 @@ bool disassemble(const Opts &opts, igax::Context &ctx,
   dopts.formatting_opts = makeFormattingOpts(opts);
   dopts.base_pc_offset = opts.pcOffset;
   setOptBit(dopts.decoder_opts, IGA_DECODING_OPT_NATIVE, opts.useNativeEncoder);
+  setOptBit(dopts.decoder_opts, IGA_DECODING_OPT_PARALLEL, opts.parallel);
+  dopts.decode_threads = opts.parallelThreads;
   try {
     auto r = ctx.disassembleToString(inp.data(), inp.size(), dopts);
     for (auto &w : r.warnings) {
@@ -354,6 +354,19 @@ extern "C" int iga_main(int argc, const char **argv) {
                   [](const char *, const opts::ErrorHandler &, Opts &baseOpts) {
                     baseOpts.printLdSt = false;
                   });
+  xGrp.defineFlag("parallel", nullptr,
+                  "decodes and formats large kernels on several threads",
+                  nullptr, opts::OptAttrs::ALLOW_UNSET, baseOpts.parallel);
+  xGrp.defineOpt(
+      "parallel-threads", nullptr, "INT",
+      "sets the number of threads used by -Xparallel",
+      "By default -Xparallel uses as many threads as the hardware can run "
+      "concurrently.  This option also enables -Xparallel.",
+      opts::OptAttrs::ALLOW_UNSET,
+      [](const char *cinp, const opts::ErrorHandler &eh, Opts &baseOpts) {
+        baseOpts.parallel = true;
+        baseOpts.parallelThreads = (uint32_t)eh.parseInt(cinp);
+      });
   xGrp.defineFlag("syntax-exts", nullptr, "enables certain syntax extensions",
                   "", opts::OptAttrs::ALLOW_UNSET, baseOpts.syntaxExts);
   xGrp.defineFlag("print-hex-floats", nullptr, "format floats in hexadecimal",
@@ -57,6 +57,8 @@ struct Opts {
   bool syntaxExts = false;                         // -Xsyntax-exts
   bool useNativeEncoder = false;                   // -Xnative
   bool forceNoCompact = false;                     // -Xforce-no-compact
+  bool parallel = false;                           // -Xparallel
+  uint32_t parallelThreads = 0;                    // -Xparallel-threads
   uint32_t pcOffset = 0; // pcOffset provided with -Xset-pc-base
 
   bool printBits = false;          // -Xprint-bits
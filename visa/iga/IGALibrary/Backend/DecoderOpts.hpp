@@ -11,6 +11,8 @@ SPDX-License-Identifier: MIT
 namespace iga {
 struct DecoderOpts {
   bool useNumericLabels;
+  // large binaries are decoded in chunks on up to this many threads
+  unsigned threads = 1;
 
   DecoderOpts(bool _useNumericLabels = false)
       : useNumericLabels(_useNumericLabels) {}
@@ -18,8 +18,11 @@ SPDX-License-Identifier: MIT
 #include "GEDToIGATranslation.hpp"
 #include "IGAToGEDTranslation.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 
 // Used to label expressions that need to be removed once GED is fixed
@@ -177,7 +180,13 @@ Kernel *Decoder::decodeKernel(const void *binary, size_t binarySize,
   // insts.reserve(binarySize / 8 + 1);
 
   // Pass 1. decode them all into Instruction objects
-  decodeInstructions(*kernel, binary, binarySize, insts);
+  std::vector<int32_t> chunkStarts = splitIntoChunks(binary, binarySize);
+  if (chunkStarts.size() > 1) {
+    decodeInstructionsParallel(*kernel, binary, binarySize, chunkStarts,
+                               insts);
+  } else {
+    decodeInstructions(*kernel, binary, binarySize, insts);
+  }
 
   if (numericLabels) {
     Block *block = kernel->createBlock();
@@ -272,14 +281,131 @@ const OpSpec *Decoder::decodeOpSpec(Op op) {
   return os;
 }
 
+// Chunks smaller than this are not worth a thread
+static const int32_t MIN_DECODE_CHUNK_SIZE = 64 * 1024;
+
+std::vector<int32_t> Decoder::splitIntoChunks(const void *binary,
+                                              size_t binarySize) const {
+  std::vector<int32_t> chunkStarts;
+  if (m_decodeThreads <= 1 ||
+      binarySize < 2 * (size_t)MIN_DECODE_CHUNK_SIZE) {
+    return chunkStarts;
+  }
+  const int32_t chunkSize =
+      std::max((int32_t)(binarySize / m_decodeThreads), MIN_DECODE_CHUNK_SIZE);
+  // an instruction's length only depends on its compaction bit, so the
+  // chunk boundaries can be found without decoding anything
+  const unsigned char *bits = (const unsigned char *)binary;
+  int32_t pc = 0, chunkStart = 0;
+  chunkStarts.push_back(0);
+  while ((size_t)pc + 4 <= binarySize) {
+    if (pc - chunkStart >= chunkSize) {
+      chunkStarts.push_back(pc);
+      chunkStart = pc;
+    }
+    uint32_t dw0;
+    memcpy(&dw0, bits + pc, sizeof(dw0));
+    pc += (dw0 >> COMPACTION_CONTROL) & 1 ? COMPACTED_SIZE : UNCOMPACTED_SIZE;
+  }
+  return chunkStarts;
+}
+
+void Decoder::decodeInstructionsParallel(
+    Kernel &kernel, const void *binary, size_t binarySize,
+    const std::vector<int32_t> &chunkStarts, InstList &insts) {
+  struct Chunk {
+    ErrorHandler errors;
+    std::unique_ptr<Kernel> kernel;
+    InstList insts;
+  };
+  const size_t numChunks = chunkStarts.size();
+  std::vector<Chunk> chunks(numChunks);
+  auto decodeChunk = [&](size_t i) {
+    Chunk &chunk = chunks[i];
+    chunk.kernel.reset(new Kernel(m_model));
+    int32_t endPc =
+        i + 1 < numChunks ? chunkStarts[i + 1] : (int32_t)binarySize;
+    try {
+      Decoder decoder(m_model, chunk.errors);
+      decoder.setSWSBEncodingMode(m_SWSBEncodeMode);
+      decoder.m_binary = binary;
+      decoder.decodeInstructions(*chunk.kernel, binary, binarySize,
+                                 chunkStarts[i], endPc, chunk.insts);
+    } catch (const FatalError &) {
+      // error is already logged
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < numChunks; i++) {
+    workers.emplace_back(decodeChunk, i);
+  }
+  decodeChunk(0);
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  // stitch the chunks back together in order
+  bool fatal = false;
+  uint32_t nextId = 1;
+  for (Chunk &chunk : chunks) {
+    for (const Diagnostic &d : chunk.errors.getWarnings()) {
+      errorHandler().reportWarning(d.at, d.message);
+    }
+    for (const Diagnostic &d : chunk.errors.getErrors()) {
+      errorHandler().reportError(d.at, d.message);
+    }
+    fatal |= chunk.errors.hasFatalError();
+    for (Instruction *inst : chunk.insts) {
+      inst->setID(nextId++);
+      insts.emplace_back(inst);
+    }
+    kernel.adoptMemory(std::move(chunk.kernel));
+  }
+  if (fatal) {
+    throw FatalError();
+  }
+}
+
+GED_RETURN_VALUE Decoder::decodeGedInst(const unsigned char *binary,
+                                        size_t binarySize, int32_t iLen) {
+  if (iLen != COMPACTED_SIZE) {
+    memset(&m_currGedInst, 0, sizeof(m_currGedInst));
+    return GED_DecodeIns(m_gedModel, binary, (uint32_t)binarySize,
+                         &m_currGedInst);
+  }
+  uint64_t compactBits;
+  memcpy(&compactBits, binary, sizeof(compactBits));
+  auto itr = m_decompactedInsts.find(compactBits);
+  if (itr != m_decompactedInsts.end()) {
+    m_currGedInst = itr->second;
+    return GED_RETURN_VALUE_SUCCESS;
+  }
+  memset(&m_currGedInst, 0, sizeof(m_currGedInst));
+  GED_RETURN_VALUE status =
+      GED_DecodeIns(m_gedModel, binary, (uint32_t)binarySize, &m_currGedInst);
+  if (status == GED_RETURN_VALUE_SUCCESS) {
+    m_decompactedInsts.emplace(compactBits, m_currGedInst);
+  }
+  return status;
+}
+
 // Pass 1. decode all instructions in Instruction*
 void Decoder::decodeInstructions(Kernel &kernel, const void *binaryStart,
                                  size_t binarySize, InstList &insts) {
+  decodeInstructions(kernel, binaryStart, binarySize, 0, (int32_t)binarySize,
+                     insts);
+}
+
+void Decoder::decodeInstructions(Kernel &kernel, const void *binaryStart,
+                                 size_t binarySize, int32_t startPc,
+                                 int32_t endPc, InstList &insts) {
   restart();
+  setPc(startPc);
   uint32_t nextId = 1;
-  const unsigned char *binary = (const unsigned char *)binaryStart;
+  const unsigned char *binary = (const unsigned char *)binaryStart + startPc;
 
-  int32_t bytesLeft = (int32_t)binarySize;
+  int32_t bytesLeft = endPc - startPc;
   while (bytesLeft > 0) {
     // need at least 4 bytes to check compaction control
     if (bytesLeft < 4) {
@@ -293,9 +419,7 @@ void Decoder::decodeInstructions(Kernel &kernel, const void *binaryStart,
       warningT("unexpected padding at end of kernel");
       break;
     }
-    memset(&m_currGedInst, 0, sizeof(m_currGedInst));
-    GED_RETURN_VALUE status =
-        GED_DecodeIns(m_gedModel, binary, (uint32_t)binarySize, &m_currGedInst);
+    GED_RETURN_VALUE status = decodeGedInst(binary, binarySize, iLen);
     Instruction *inst = nullptr;
     if (status == GED_RETURN_VALUE_NO_COMPACT_FORM) {
       errorT("error decoding instruction (no compacted form)");
@@ -13,6 +13,9 @@ SPDX-License-Identifier: MIT
 #include "GEDToIGATranslation.hpp"
 #include "ged.h"
 
+#include <unordered_map>
+#include <vector>
+
 #define GED_DECODE_TO(FIELD, TRANS, DST)                                       \
   do {                                                                         \
     GED_RETURN_VALUE _status;                                                  \
@@ -113,6 +116,9 @@ public:
     }
   }
 
+  // Decode large binaries in chunks on up to this many threads
+  void setDecodeThreads(unsigned threads) { m_decodeThreads = threads; }
+
   bool isMacro() const;
 
 private:
@@ -122,6 +128,23 @@ private:
   // pass 1 decodes instructions with numeric labels
   void decodeInstructions(Kernel &kernel, const void *binary, size_t binarySize,
                           InstList &insts);
+  // pass 1 over the instructions in [startPc, endPc) of the binary
+  void decodeInstructions(Kernel &kernel, const void *binary, size_t binarySize,
+                          int32_t startPc, int32_t endPc, InstList &insts);
+  // pass 1 split over several threads, each chunk is decoded into its own
+  // kernel, which the returned kernel adopts
+  void decodeInstructionsParallel(Kernel &kernel, const void *binary,
+                                  size_t binarySize,
+                                  const std::vector<int32_t> &chunkStarts,
+                                  InstList &insts);
+  // chunk boundaries at instruction starts, empty if the binary is too
+  // small to be worth splitting
+  std::vector<int32_t> splitIntoChunks(const void *binary,
+                                       size_t binarySize) const;
+  // GED_DecodeIns into m_currGedInst, reusing earlier expansions of the
+  // same compacted instruction
+  GED_RETURN_VALUE decodeGedInst(const unsigned char *binary,
+                                 size_t binarySize, int32_t iLen);
   const OpSpec *decodeOpSpec(Op op);
 
   Instruction *decodeNextInstruction(Kernel &kernel);
@@ -405,6 +428,13 @@ protected:
   // SWSB encoding mode
   SWSB_ENCODE_MODE m_SWSBEncodeMode = SWSB_ENCODE_MODE::SWSBInvalidMode;
 
+  unsigned m_decodeThreads = 1;
+
+  // GED expands a compacted instruction through its compaction tables field
+  // by field; compacted encodings repeat a lot within a kernel, so the
+  // decoded GED state is kept per compacted encoding
+  std::unordered_map<uint64_t, ged_ins_t> m_decompactedInsts;
+
   // for GED workarounds: grab specific bits from the current instruction
   uint32_t getBitField(int ix, int len) const;
 
@@ -37,6 +37,7 @@ Kernel *iga::ged::Decode(const Model &m, const DecoderOpts &dopts,
   Kernel *k = nullptr;
   try {
     iga::Decoder decoder(m, eh);
+    decoder.setDecodeThreads(dopts.threads);
     k = dopts.useNumericLabels ? decoder.decodeKernelNumeric(bits, bitsLen)
                                : decoder.decodeKernelBlocks(bits, bitsLen);
   } catch (FatalError) {
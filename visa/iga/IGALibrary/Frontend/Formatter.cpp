@@ -30,6 +30,7 @@ SPDX-License-Identifier: MIT
 #include <cstring>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 namespace iga {
@@ -130,6 +131,15 @@ public:
 
   void formatKernel(const Kernel &k, const void *vbits) {
     currInstBits = (const uint8_t *)vbits;
+    formatLiveIn();
+
+    for (const Block *b : k.getBlockList()) {
+      formatBlockLabel(*b);
+      formatBlockContents(*b);
+    }
+  }
+
+  void formatLiveIn() {
     if (opts.printInstDefs && opts.liveAnalysis) {
       std::stringstream ss;
       ss << "// itrs: " << opts.liveAnalysis->iterations << "\n";
@@ -154,20 +164,24 @@ public:
       }
       emitAnsi(ANSI_FADED, ss.str());
     }
+  }
 
-    for (const Block *b : k.getBlockList()) {
-      if (!opts.numericLabels) {
-        formatLabel(b->getPC());
-        emit(':');
-        newline();
-      }
-
-      formatBlockContents(*b);
+  void formatBlockLabel(const Block &b) {
+    if (!opts.numericLabels) {
+      formatLabel(b.getPC());
+      emit(':');
+      newline();
     }
   }
 
   void formatBlockContents(const Block &b) {
-    for (const auto &i : b.getInstList()) {
+    formatInstructions(b.getInstList().begin(), b.getInstList().end());
+  }
+
+  void formatInstructions(InstList::const_iterator begin,
+                          InstList::const_iterator end) {
+    for (auto itr = begin; itr != end; ++itr) {
+      const Instruction *i = *itr;
       formatInstruction(*i);
       newline();
 
@@ -177,6 +191,17 @@ public:
     }
   }
 
+  // formats part of a kernel starting at instruction 'begin'; bits are
+  // those of the whole kernel
+  void formatInstructions(InstList::const_iterator begin,
+                          InstList::const_iterator end, const void *vbits) {
+    currInstBits = nullptr;
+    if (vbits && begin != end) {
+      currInstBits = (const uint8_t *)vbits + (*begin)->getPC();
+    }
+    formatInstructions(begin, end);
+  }
+
   void formatPrefixComment(const Instruction &i, const void *vbits) {
     bool printBits = opts.printInstBits && currInstBits != nullptr;
     bool printInstId = opts.printInstDefs;
@@ -1383,6 +1408,81 @@ void FormatOpts::addApiOpts(uint32_t fmtOpts, uint32_t pcOff) {
   basePCOffset = pcOff;
 }
 
+// Slices with fewer instructions than this are not worth a thread
+static const size_t MIN_FORMAT_SLICE_INSTS = 4096;
+
+// Formats the kernel in slices of about the same number of instructions on
+// separate threads and writes their text out in order.  Instructions are
+// formatted independently of each other, so only a slice starting a block
+// needs to print that block's label.
+static void FormatKernelParallel(ErrorHandler &e, std::ostream &o,
+                                 const FormatOpts &opts, const Kernel &k,
+                                 const void *bits) {
+  struct Span {
+    const Block *block;
+    InstList::const_iterator begin, end;
+    bool printLabel;
+  };
+  struct Slice {
+    std::vector<Span> spans;
+    ErrorHandler errors;
+    std::stringstream text;
+  };
+
+  const size_t sliceInsts = std::max(
+      k.getInstructionCount() / opts.threads + 1, MIN_FORMAT_SLICE_INSTS);
+  std::vector<Slice> slices(1);
+  size_t instsInSlice = 0;
+  for (const Block *b : k.getBlockList()) {
+    const InstList &il = b->getInstList();
+    auto spanBegin = il.begin();
+    bool printLabel = true;
+    for (auto itr = il.begin(); itr != il.end(); ++itr) {
+      if (instsInSlice == sliceInsts) {
+        slices.back().spans.push_back({b, spanBegin, itr, printLabel});
+        slices.emplace_back();
+        instsInSlice = 0;
+        spanBegin = itr;
+        printLabel = false;
+      }
+      instsInSlice++;
+    }
+    slices.back().spans.push_back({b, spanBegin, il.end(), printLabel});
+  }
+
+  auto formatSlice = [&](Slice &slice) {
+    Formatter f(slice.errors, slice.text, opts);
+    for (const Span &span : slice.spans) {
+      if (span.printLabel) {
+        f.formatBlockLabel(*span.block);
+      }
+      f.formatInstructions(span.begin, span.end, bits);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < slices.size(); i++) {
+    workers.emplace_back(formatSlice, std::ref(slices[i]));
+  }
+  {
+    Formatter f(e, o, opts);
+    f.formatLiveIn();
+  }
+  formatSlice(slices[0]);
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  for (Slice &slice : slices) {
+    for (const Diagnostic &d : slice.errors.getWarnings()) {
+      e.reportWarning(d.at, d.message);
+    }
+    for (const Diagnostic &d : slice.errors.getErrors()) {
+      e.reportError(d.at, d.message);
+    }
+    o << slice.text.rdbuf();
+  }
+}
+
 void FormatKernel(ErrorHandler &e, std::ostream &o, const FormatOpts &opts,
                   const Kernel &k, const void *bits) {
   IGA_ASSERT(k.getModel().platform == opts.model.platform,
@@ -1395,6 +1495,11 @@ void FormatKernel(ErrorHandler &e, std::ostream &o, const FormatOpts &opts,
     return;
   }
   if (!opts.printJson) {
+    if (opts.threads > 1 &&
+        k.getInstructionCount() >= 2 * MIN_FORMAT_SLICE_INSTS) {
+      FormatKernelParallel(e, o, opts, k, bits);
+      return;
+    }
     Formatter f(e, o, opts);
     f.formatKernel(k, (const uint8_t *)bits);
   } else {
@@ -49,6 +49,9 @@ struct FormatOpts {
   int printJsonVersion = 1;
   DepAnalysis *liveAnalysis = nullptr;
   uint32_t basePCOffset = 0;
+  // large kernels are formatted in slices on up to this many threads;
+  // the labeler must then be safe to call concurrently
+  unsigned threads = 1;
 
   // format with default labels
   FormatOpts(const Model &m) : model(m) {}
@@ -28,6 +28,10 @@ Kernel::~Kernel() {
   }
 }
 
+void Kernel::adoptMemory(std::unique_ptr<Kernel> part) {
+  m_adoptedParts.push_back(std::move(part));
+}
+
 void Kernel::resetIds() {
   // algorithm to set the IDs
   int blockIndex = 0, instIndex = 0;
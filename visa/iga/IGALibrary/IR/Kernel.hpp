@@ -20,6 +20,8 @@ SPDX-License-Identifier: MIT
 #include "Instruction.hpp"
 
 #include <list>
+#include <memory>
+#include <vector>
 
 namespace iga {
 typedef std::list<iga::Block *, std_arena_based_allocator<iga::Block *>>
@@ -51,6 +53,11 @@ public:
   Block *createBlock();
   void appendBlock(Block *blk);
 
+  // Keeps another kernel alive as long as this one so that instructions
+  // created in it can be appended to this kernel's blocks
+  // (e.g. when parts of a binary are decoded on separate threads)
+  void adoptMemory(std::unique_ptr<Kernel> part);
+
   // Instruction constructors, the instruction returned must be appended
   // to a block or some other storage
   Instruction *createBasicInstruction(const OpSpec &op, const Predication &pred,
@@ -86,6 +93,8 @@ private:
   MemManager m_mem;
 
   BlockList m_blocks;
+
+  std::vector<std::unique_ptr<Kernel>> m_adoptedParts;
 };
 } // namespace iga
 
@@ -29,6 +29,7 @@ SPDX-License-Identifier: MIT
 #include <map>
 #include <ostream>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -392,6 +393,14 @@ public:
     return translateDiagnostics(errHandler);
   }
 
+  static unsigned decodeThreads(const iga_disassemble_options_t &dopts) {
+    if ((dopts.decoder_opts & IGA_DECODING_OPT_PARALLEL) == 0)
+      return 1;
+    if (dopts.decode_threads != 0)
+      return dopts.decode_threads;
+    return std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
   FormatOpts formatterOpts(
       const iga_disassemble_options_t &dopts,
       const char *(*formatLabel)(int32_t, void *), void *formatLabelEnv,
@@ -400,6 +409,7 @@ public:
       SWSB_ENCODE_MODE swsbEnMod = SWSB_ENCODE_MODE::SWSBInvalidMode) {
     FormatOpts fopts(m_model, formatLabel, formatLabelEnv);
     fopts.addApiOpts(dopts.formatting_opts, dopts.base_pc_offset);
+    fopts.threads = decodeThreads(dopts);
     if (swsbEnMod == SWSB_ENCODE_MODE::SWSBInvalidMode)
       fopts.setSWSBEncodingMode(m_model.getSWSBEncodeMode());
     else
@@ -436,6 +446,7 @@ public:
     checkForLegacyFields(dopts, errHandler);
     DecoderOpts dopts2(
         (dopts.formatting_opts & IGA_FORMATTING_OPT_NUMERIC_LABELS) != 0);
+    dopts2.threads = decodeThreads(dopts);
     if ((dopts.decoder_opts & IGA_DECODING_OPT_NATIVE) == 0) {
       if (!iga::ged::IsDecodeSupported(m_model, dopts2)) {
         return IGA_UNSUPPORTED_PLATFORM;
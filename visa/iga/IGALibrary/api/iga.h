@@ -372,11 +372,14 @@ typedef struct {
   uint32_t decoder_opts;    /* opts for the decoding phase */
   uint32_t base_pc_offset;  /* base pc offset to add to pc in disassembly string
                                output*/
+  uint32_t decode_threads;  /* threads used with IGA_DECODING_OPT_PARALLEL;
+                               0 means the hardware concurrency */
+  uint32_t _reserved2;      /* set this to 0! */
   /* ... future fields (ensure total size is a multiple of 8;
    * add "reserved" if needed) ... */
 } iga_disassemble_options_t;
 
-static_assert(sizeof(iga_disassemble_options_t) == 6 * 4,
+static_assert(sizeof(iga_disassemble_options_t) == 8 * 4,
               "wrong size for iga_disassemble_options_t");
 
 /* A default value for iga_disassemble_options_t */
@@ -386,6 +389,8 @@ static_assert(sizeof(iga_disassemble_options_t) == 6 * 4,
         0,                         /* _reserved0 */                            \
         0,                         /* _reserved1 */                            \
         IGA_DECODING_OPTS_DEFAULT, /* decoder_opts */                          \
+        0,                         /* base_pc_offset */                        \
+        0,                         /* decode_threads */                        \
   }
 
 /* A default value for iga_disassemble_options_t that enables numeric labels */
@@ -396,6 +401,8 @@ static_assert(sizeof(iga_disassemble_options_t) == 6 * 4,
         0,                         /* _reserved0 */                            \
         0,                         /* _reserved1 */                            \
         IGA_DECODING_OPTS_DEFAULT, /* decoder_opts */                          \
+        0,                         /* base_pc_offset */                        \
+        0,                         /* decode_threads */                        \
   }
 
 /*
@@ -437,6 +444,10 @@ static_assert(sizeof(iga_disassemble_options_t) == 6 * 4,
 
 /* uses the native decoder for decoding the kernel */
 #define IGA_DECODING_OPT_NATIVE 0x00000001u
+/* decodes and formats large kernels in chunks on several threads;
+ * a label callback passed to iga_context_disassemble must then be
+ * safe to call concurrently */
+#define IGA_DECODING_OPT_PARALLEL 0x00000002u
 /* just the default decoding opts */
 #define IGA_DECODING_OPTS_DEFAULT (0u)
 
@@ -1255,6 +1255,12 @@ public:
   ParseVISAText(const std::string &visaText,
                 const std::string &visaTextFile) = 0;
   VISA_BUILDER_API virtual int ParseVISAText(const std::string &visaFile) = 0;
+  // Parse the vISA text of an inline asm block and append its declarations
+  // and instructions to kernel. It may refer to variables of kernel by name,
+  // which requires the vISA_MergeInlineAsm option to be set before kernel is
+  // created.
+  VISA_BUILDER_API virtual int ParseVISAInlineAsm(VISAKernel *kernel,
+                                                  const std::string &visaText) = 0;
   VISA_BUILDER_API virtual std::stringstream &GetAsmTextStream() = 0;
   VISA_BUILDER_API virtual VISAKernel *
   GetVISAKernel(const std::string &kernelName = "") const = 0;
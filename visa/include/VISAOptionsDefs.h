@@ -55,6 +55,10 @@ DEF_VISA_OPTION(vISA_DebugConsoleDump, ET_BOOL, "-dumpDebugConsoleOutput",
 DEF_VISA_OPTION(vISA_EmitLocation, ET_BOOL, "-emitLocation", UNUSED, false)
 DEF_VISA_OPTION(vISA_dumpRPE, ET_BOOL, "-dumpRPE", UNUSED, false)
 DEF_VISA_OPTION(vISA_dumpLiveness, ET_BOOL, "-dumpLiveness", UNUSED, false)
+DEF_VISA_OPTION(vISA_LivenessFullSweep, ET_BOOL, "-livenessFullSweep",
+                "USAGE: -livenessFullSweep solves liveness by sweeping all BBs "
+                "until nothing changes instead of with a worklist",
+                false)
 DEF_VISA_OPTION(vISA_DumpUndefUsesFromLiveness, ET_BOOL,
                 "-dumpUndefUsesFromLiveness", UNUSED, false)
 DEF_VISA_OPTION(vISA_disableInstDebugInfo, ET_BOOL, "-disableInstDebugInfo",
@@ -327,6 +331,12 @@ DEF_VISA_OPTION(vISA_DumpLiveRanges, ET_BOOL, "-dumplrs", UNUSED, false)
 DEF_VISA_OPTION(vISA_FailSafeRALimit, ET_INT32, "-failSafeRALimit", UNUSED, 3)
 DEF_VISA_OPTION(vISA_DenseMatrixLimit, ET_INT32, "-denseMatrixLimit", UNUSED,
                 0x800)
+DEF_VISA_OPTION(vISA_IntfBuildThreads, ET_INT32, "-intfBuildThreads",
+                "USAGE: -intfBuildThreads <n> where n is the number of threads "
+                "building the interference graph, 0 or 1 builds it serially",
+                0)
+DEF_VISA_OPTION(vISA_VerifyIntfBuild, ET_BOOL, "-verifyIntfBuild", UNUSED,
+                false)
 DEF_VISA_OPTION(vISA_FillConstOpt, ET_BOOL, "-nofillconstopt", UNUSED, true)
 DEF_VISA_OPTION(vISA_GCRRInFF, ET_BOOL, "-GCRRinFF", UNUSED, false)
 DEF_VISA_OPTION(vISA_IncrementalRA, ET_INT32, "-incrementalra",
@@ -347,6 +357,10 @@ DEF_VISA_OPTION(vISA_preRA_ScheduleRPThreshold, ET_INT32, "-presched-rp",
                 "USAGE: -presched-rp <threshold>\n", 0)
 DEF_VISA_OPTION(vISA_preRA_ScheduleExtraGRF, ET_INT32, "-presched-extra-grf",
                 "USAGE: -presched-extra-grf <num>\n", 0)
+DEF_VISA_OPTION(vISA_preRA_ScheduleThreads, ET_INT32, "-presched-threads",
+                "USAGE: -presched-threads <n> where n is the number of threads "
+                "scheduling blocks, 0 or 1 schedules them serially",
+                0)
 DEF_VISA_OPTION(vISA_ScheduleStartBBID, ET_INT32, "-sched-start",
                 "USAGE: -sched-start <BB ID>\n", 0)
 DEF_VISA_OPTION(vISA_ScheduleEndBBID, ET_INT32, "-sched-end",
@@ -414,6 +428,10 @@ DEF_VISA_OPTION(vISA_forceDebugSWSB, ET_BOOL, "-forceDebugSWSB", UNUSED, false)
 DEF_VISA_OPTION(vISA_SWSBInstStall, ET_INT32, "-SWSBInstStall", UNUSED, 0)
 DEF_VISA_OPTION(vISA_SWSBInstStallEnd, ET_INT32, "-SWSBInstStallEnd", UNUSED, 0)
 DEF_VISA_OPTION(vISA_SWSBTokenBarrier, ET_INT32, "-SWSBTokenBarrier", UNUSED, 0)
+DEF_VISA_OPTION(vISA_SWSBThreads, ET_INT32, "-SWSBThreads",
+                "USAGE: -SWSBThreads <n> where n is the number of threads "
+                "computing operand footprints, 0 or 1 computes them serially",
+                0)
 DEF_VISA_OPTION(vISA_EnableSwitch, ET_BOOL, "-enableSwitch", UNUSED, false)
 DEF_VISA_OPTION(vISA_EnableISBIDBUNDLE, ET_BOOL, "-SBIDBundle", UNUSED, false)
 DEF_VISA_OPTION(vISA_EnableGroupScheduleForBC, ET_BOOL, "-groupScheduleForBC",
@@ -461,6 +479,12 @@ DEF_VISA_OPTION(vISA_SelectiveRAInstThreshold, ET_INT32, "-selectiveRAInstThresh
                 UNUSED, 128*1024)
 DEF_VISA_OPTION(vISA_SelectiveRAGlobaVarRatioThreshold, ET_CSTR, "-selectiveRAGVRatioThreshold",
                 UNUSED, "0.16")
+DEF_VISA_OPTION(vISA_CompileTimeBudget, ET_INT32, "-compileTimeBudget",
+                "USAGE: -compileTimeBudget <milliseconds>. Switch to cheaper "
+                "strategies (no pre-RA scheduling, fast RA, early fail safe "
+                "RA) for a kernel that is large for the budget. 0 disables "
+                "the budget.",
+                0)
 DEF_VISA_OPTION(vISA_EnableSwapAccSub, ET_BOOL, "-swapAccSub", UNUSED, true)
 DEF_VISA_OPTION(vISA_EnableRRAccSub, ET_BOOL, "-roundRobinAccSub", UNUSED,
                 false)
@@ -528,6 +552,9 @@ DEF_VISA_OPTION(vISA_NoVerifyvISA, ET_BOOL, "-noverifyCISA", UNUSED, false)
 DEF_VISA_OPTION(vISA_InitPayload, ET_BOOL, "-initializePayload", UNUSED, false)
 DEF_VISA_OPTION(vISA_AvoidUsingR0R1, ET_BOOL, "-avoidR0R1", UNUSED, false)
 DEF_VISA_OPTION(vISA_isParseMode, ET_BOOL, NULLSTR, UNUSED, false)
+// Set by clients that parse inline vISA asm into in-memory kernels with
+// ParseVISAInlineAsm; keeps a by-name index of all variables.
+DEF_VISA_OPTION(vISA_MergeInlineAsm, ET_BOOL, NULLSTR, UNUSED, false)
 DEF_VISA_OPTION(vISA_ReRAPostSchedule, ET_BOOL, "-rerapostschedule",
                 "DEPRECATED, is a nop", false)
 DEF_VISA_OPTION(vISA_GTPinReRA, ET_BOOL, "-GTPinReRA", "DEPRECATED, is a nop", false)
@@ -669,6 +696,11 @@ DEF_VISA_OPTION(vISA_ScratchAllocForStackInKB, ET_INT32,
 DEF_VISA_OPTION(vISA_dumpToCurrentDir, ET_BOOL, "-dumpToCurrentDir", UNUSED,
                 false)
 DEF_VISA_OPTION(vISA_dumpTimer, ET_BOOL, "-timestats", UNUSED, false)
+DEF_VISA_OPTION(vISA_dumpPassStats, ET_BOOL, "-dumpPassStats",
+                "Dump the time, instruction count change and kernel arena bytes "
+                "of each optimizer pass to <asm>.passes.json and "
+                "<asm>.passes.csv.",
+                false)
 DEF_VISA_OPTION(vISA_ShaderDataBaseStats, ET_BOOL, "--sdbStats", UNUSED, false)
 DEF_VISA_OPTION(vISA_ShaderDataBaseStatsFilePath, ET_CSTR, "-sdbStatsFile",
                 UNUSED, NULL)
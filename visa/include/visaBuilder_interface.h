@@ -26,4 +26,15 @@ extern "C" int CreateVISABuilder(VISABuilder *&builder, vISABuilderMode mode,
 extern "C" int DestroyVISABuilder(VISABuilder *&builder);
 
 // Interface to free the kernel ISA and debug info binary.
-extern "C" void freeBlock(void *ptr);
\ No newline at end of file
+extern "C" void freeBlock(void *ptr);
+
+// Timeline of compile-time spans in the Chrome trace-event JSON format, shared
+// by the client and vISA, which adds a span for every run of its timers.
+// Spans are recorded per thread. vISAWriteTraceEvents appends the spans ended
+// since its last call to fileName, which thus grows into the trace of all
+// compiles of the process. The category must be a string literal.
+extern "C" void vISAEnableTraceEvents(const char *fileName);
+extern "C" bool vISATraceEventsEnabled();
+extern "C" void vISABeginTraceEvent(const char *name, const char *category);
+extern "C" void vISAEndTraceEvent(const char *name);
+extern "C" void vISAWriteTraceEvents();
\ No newline at end of file
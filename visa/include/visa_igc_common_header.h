@@ -931,5 +931,21 @@ enum FFID {
   FFID_INVALID = 0xFF
 };
 
+// Cost model of the compile-time budget (vISA -compileTimeBudget, IGC
+// CompileTimeBudgetMs). The backend handles about SizePerMs instructions,
+// declares and blocks in a millisecond, so a kernel is expected to take
+// size / (SizePerMs * budget) of the budget. Cheaper strategies kick in as
+// that share crosses each threshold. Elapsed time is not used, so that the
+// generated code does not depend on machine load.
+namespace CompileTimeBudget {
+constexpr unsigned SizePerMs = 200;
+// No SIMD32 and no pre-RA scheduling.
+constexpr double NoScheduleShare = 0.25;
+// Fast RA instead of graph coloring.
+constexpr double FastRAShare = 0.5;
+// Fail safe RA right away.
+constexpr double FailSafeRAShare = 1.0;
+} // namespace CompileTimeBudget
+
 
 #endif // _VISA_IGC_COMMON_HEADER_H_